@@ -0,0 +1,655 @@
+#ifndef BPlusTree_hpp
+#define BPlusTree_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//
+// Position of the first of the sorted keys[0..n) that is not ordered before
+// x, as std::lower_bound.
+//
+template<typename Key, typename Compare>
+inline int NodeLowerBound(const Key *keys, int n, const Key &x, const Compare &comp)
+{
+    return std::lower_bound(keys, keys + n, x, comp) - keys;
+}
+
+//
+// For integer keys in their natural order, the same position is the number
+// of keys below x, which a vector scan counts without a single branch on
+// the keys. A node spans only a few cache lines, all of which the binary
+// search would touch anyway. Uses AVX2 when compiled with it, SSE (SSE4.2
+// for 64-bit keys) otherwise, and a plain loop on other targets.
+//
+inline int NodeLowerBound(const std::int32_t *keys, int n, std::int32_t x,
+                          const std::less<std::int32_t>&)
+{
+    int i = 0, count = 0;
+#if defined(__AVX2__)
+    const __m256i vx = _mm256_set1_epi32(x);
+    for (; i + 8 <= n; i += 8) {
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        __m256i below = _mm256_cmpgt_epi32(vx, k);
+        count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(below)));
+    }
+#elif defined(__SSE2__)
+    const __m128i vx = _mm_set1_epi32(x);
+    for (; i + 4 <= n; i += 4) {
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        __m128i below = _mm_cmplt_epi32(k, vx);
+        count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(below)));
+    }
+#endif
+    for (; i < n; i++)
+        count += keys[i] < x;
+    return count;
+}
+
+inline int NodeLowerBound(const std::int64_t *keys, int n, std::int64_t x,
+                          const std::less<std::int64_t>&)
+{
+    int i = 0, count = 0;
+#if defined(__AVX2__)
+    const __m256i vx = _mm256_set1_epi64x(x);
+    for (; i + 4 <= n; i += 4) {
+        __m256i k = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        __m256i below = _mm256_cmpgt_epi64(vx, k);
+        count += __builtin_popcount(_mm256_movemask_pd(_mm256_castsi256_pd(below)));
+    }
+#elif defined(__SSE4_2__)
+    const __m128i vx = _mm_set1_epi64x(x);
+    for (; i + 2 <= n; i += 2) {
+        __m128i k = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+        __m128i below = _mm_cmpgt_epi64(vx, k);
+        count += __builtin_popcount(_mm_movemask_pd(_mm_castsi128_pd(below)));
+    }
+#endif
+    for (; i < n; i++)
+        count += keys[i] < x;
+    return count;
+}
+
+template<typename V, int N>
+struct BPlusLeafValues {
+    V values[N];
+};
+
+template<int N>
+struct BPlusLeafValues<void, N> {};
+
+//
+// A B+-tree holding unique keys, with a Value for each when Value is not
+// void (an ordered map) and none otherwise (an ordered set). All keys live
+// in the leaves, which are chained in order for range iteration; the inner
+// nodes only route searches, their i-th key bounding the keys of child i
+// from above and those of child i + 1 from below.
+//
+// A node holds up to B keys in a sorted array, so a search touches a
+// handful of nodes of a few cache lines each, instead of chasing one
+// pointer per level as RbTree does. B defaults to 256 bytes worth of keys
+// (64 ints or 32 64-bit integers); a B near 4096 / sizeof(Key) suits trees
+// that are paged in from disk. Every node other than the root stays at
+// least half full.
+//
+// The interface follows RbTree, with iterators standing in for nodes and
+// end() for NIL: Search, Minimum, Maximum, Successor and Predecessor, plus
+// LowerBound, UpperBound and begin()/end() for ranges. Iterators stay valid
+// until the next Insert or Erase.
+//
+template<typename Key, typename Value = void, typename Compare = std::less<Key>,
+         int B = std::max<int>(8, 256 / static_cast<int>(sizeof(Key)))>
+class BPlusTree {
+    static_assert(B >= 4, "nodes need room for at least four keys");
+
+    static constexpr bool IS_MAP = !std::is_void<Value>::value;
+    static constexpr int MIN = B / 2;  // fewest keys in a node but the root
+    static constexpr int MAX_DEPTH = 64;
+
+    struct Node {
+        bool leaf;
+        int n {0};  // number of keys
+
+        explicit Node(bool _leaf) : leaf{_leaf} {}
+    };
+
+    struct Inner : Node {
+        Key keys[B];
+        Node *child[B + 1];
+
+        Inner() : Node(false) {}
+    };
+
+    struct Leaf : Node, BPlusLeafValues<Value, B> {
+        Key keys[B];
+        Leaf *prev {nullptr};
+        Leaf *next {nullptr};
+
+        Leaf() : Node(true) {}
+    };
+
+public:
+    using value_type = Key;
+
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        Iterator() = default;
+
+        const Key& operator*() const
+        {
+            return leaf_->keys[i_];
+        }
+        const Key* operator->() const
+        {
+            return &leaf_->keys[i_];
+        }
+
+        // The value mapped to the key, for maps.
+        template<typename V = Value>
+        typename std::enable_if<!std::is_void<V>::value, V&>::type value() const
+        {
+            return leaf_->values[i_];
+        }
+
+        Iterator& operator++()
+        {
+            if (++i_ == leaf_->n)
+                leaf_ = leaf_->next, i_ = 0;
+            return *this;
+        }
+        Iterator operator++(int)
+        {
+            Iterator copy(*this);
+            ++*this;
+            return copy;
+        }
+        Iterator& operator--()
+        {
+            if (leaf_ == nullptr)
+                leaf_ = tree_->tail_, i_ = leaf_->n - 1;
+            else if (i_ == 0)
+                leaf_ = leaf_->prev, i_ = leaf_->n - 1;
+            else
+                --i_;
+            return *this;
+        }
+        Iterator operator--(int)
+        {
+            Iterator copy(*this);
+            --*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator &it) const
+        {
+            return leaf_ == it.leaf_ && i_ == it.i_;
+        }
+        bool operator!=(const Iterator &it) const
+        {
+            return !(*this == it);
+        }
+
+    private:
+        friend class BPlusTree;
+        Iterator(const BPlusTree *tree, Leaf *leaf, int i) : tree_{tree}, leaf_{leaf}, i_{i} {}
+
+        const BPlusTree *tree_ {nullptr};
+        Leaf *leaf_ {nullptr};  // nullptr at the end
+        int i_ {0};
+    };
+
+    explicit BPlusTree(const Compare &comp = Compare()) : comp_{comp} {}
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    //
+    // Inserts key, with a value for maps, unless it is already present;
+    // returns whether it was inserted. A full node is split in two halves.
+    //
+    // Time Complexity: O(B log_B n)
+    //
+    template<typename... Args>
+    bool Insert(const Key &key, Args&&... value);
+
+    //
+    // Erases key, returning whether it was present. A node falling below
+    // half full borrows a key from a sibling or is merged with it.
+    //
+    // Time Complexity: O(B log_B n)
+    //
+    bool Erase(const Key &key);
+
+    //
+    // Time Complexity: O(lg B log_B n)
+    //
+    Iterator Search(const Key &key) const;
+    Iterator LowerBound(const Key &key) const;  // first key not below key
+    Iterator UpperBound(const Key &key) const;  // first key above key
+
+    Iterator Minimum() const;
+    Iterator Maximum() const;
+    Iterator Successor(Iterator it) const;
+    Iterator Predecessor(Iterator it) const;  // end() for the minimum
+
+    Iterator begin() const;
+    Iterator end() const;
+
+    size_t size() const;
+    bool empty() const;
+
+    void Clear();
+    ~BPlusTree();
+
+private:
+    Node *root_ {nullptr};
+    Leaf *head_ {nullptr};  // the leftmost leaf
+    Leaf *tail_ {nullptr};  // the rightmost leaf
+    size_t size_ {0};
+    Compare comp_;
+
+    int Find(const Key *keys, int n, const Key &key) const
+    {
+        return NodeLowerBound(keys, n, key, comp_);
+    }
+
+    Leaf* Descend(const Key &key, Inner **path, int *slot, int &depth) const;
+
+    template<typename... Args>
+    static void InsertAt(Leaf *leaf, int i, const Key &key, Args&&... value);
+    static void MoveEntries(Leaf *from, int first, int last, Leaf *to, int at);
+    static void RemoveChild(Inner *x, int i);
+    void Unlink(Leaf *leaf);
+    void Free(Node *x);
+};
+
+template<typename Key, typename Value, typename Compare, int B>
+template<typename... Args>
+bool BPlusTree<Key, Value, Compare, B>::Insert(const Key &key, Args&&... value)
+{
+    static_assert(sizeof...(Args) == (IS_MAP ? 1 : 0), "maps take a value, sets do not");
+    if (root_ == nullptr)
+        root_ = head_ = tail_ = new Leaf;
+
+    Inner *path[MAX_DEPTH];
+    int slot[MAX_DEPTH], depth = 0;
+    Leaf *leaf = Descend(key, path, slot, depth);
+    const int i = Find(leaf->keys, leaf->n, key);
+    if (i < leaf->n && !comp_(key, leaf->keys[i]))
+        return false;
+    ++size_;
+    if (leaf->n < B) {
+        InsertAt(leaf, i, key, std::forward<Args>(value)...);
+        return true;
+    }
+
+    // Split the leaf: of the B + 1 keys, the left one keeps h.
+    Leaf *right = new Leaf;
+    right->prev = leaf, right->next = leaf->next;
+    (leaf->next != nullptr ? leaf->next->prev : tail_) = right;
+    leaf->next = right;
+    const int h = (B + 1) / 2;
+    if (i < h) {
+        MoveEntries(leaf, h - 1, B, right, 0);
+        leaf->n = h - 1, right->n = B - h + 1;
+        InsertAt(leaf, i, key, std::forward<Args>(value)...);
+    } else {
+        MoveEntries(leaf, h, B, right, 0);
+        leaf->n = h, right->n = B - h;
+        InsertAt(right, i - h, key, std::forward<Args>(value)...);
+    }
+    Key separator = leaf->keys[leaf->n - 1];
+    Node *added = right;
+
+    // Add the new node next to the one split, splitting full parents too.
+    while (depth > 0) {
+        Inner *x = path[--depth];
+        const int s = slot[depth];
+        if (x->n < B) {
+            std::move_backward(x->keys + s, x->keys + x->n, x->keys + x->n + 1);
+            std::move_backward(x->child + s + 1, x->child + x->n + 1, x->child + x->n + 2);
+            x->keys[s] = std::move(separator);
+            x->child[s + 1] = added;
+            ++x->n;
+            return true;
+        }
+        Key keys[B + 1];
+        Node *child[B + 2];
+        std::move(x->keys, x->keys + s, keys);
+        keys[s] = std::move(separator);
+        std::move(x->keys + s, x->keys + B, keys + s + 1);
+        std::copy(x->child, x->child + s + 1, child);
+        child[s + 1] = added;
+        std::copy(x->child + s + 1, x->child + B + 1, child + s + 2);
+
+        // the left half keeps B / 2 keys, the middle one moves up
+        const int m = B / 2;
+        Inner *y = new Inner;
+        std::move(keys, keys + m, x->keys);
+        std::copy(child, child + m + 1, x->child);
+        x->n = m;
+        std::move(keys + m + 1, keys + B + 1, y->keys);
+        std::copy(child + m + 1, child + B + 2, y->child);
+        y->n = B - m;
+        separator = std::move(keys[m]);
+        added = y;
+    }
+    Inner *root = new Inner;
+    root->keys[0] = std::move(separator);
+    root->child[0] = root_;
+    root->child[1] = added;
+    root->n = 1;
+    root_ = root;
+    return true;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+bool BPlusTree<Key, Value, Compare, B>::Erase(const Key &key)
+{
+    if (root_ == nullptr)
+        return false;
+    Inner *path[MAX_DEPTH];
+    int slot[MAX_DEPTH], depth = 0;
+    Leaf *leaf = Descend(key, path, slot, depth);
+    const int i = Find(leaf->keys, leaf->n, key);
+    if (i == leaf->n || comp_(key, leaf->keys[i]))
+        return false;
+    --size_;
+    MoveEntries(leaf, i + 1, leaf->n, leaf, i);
+    --leaf->n;
+
+    if (depth == 0) {
+        if (leaf->n == 0) {
+            delete leaf;
+            root_ = head_ = tail_ = nullptr;
+        }
+        return true;
+    }
+    if (leaf->n >= MIN)
+        return true;
+
+    Inner *p = path[depth - 1];
+    int s = slot[depth - 1];
+    Leaf *left = s > 0 ? static_cast<Leaf*>(p->child[s - 1]) : nullptr;
+    Leaf *right = s < p->n ? static_cast<Leaf*>(p->child[s + 1]) : nullptr;
+    if (left != nullptr && left->n > MIN) {
+        MoveEntries(leaf, 0, leaf->n, leaf, 1);
+        MoveEntries(left, left->n - 1, left->n, leaf, 0);
+        ++leaf->n, --left->n;
+        p->keys[s - 1] = left->keys[left->n - 1];
+        return true;
+    }
+    if (right != nullptr && right->n > MIN) {
+        MoveEntries(right, 0, 1, leaf, leaf->n);
+        MoveEntries(right, 1, right->n, right, 0);
+        ++leaf->n, --right->n;
+        p->keys[s] = leaf->keys[leaf->n - 1];
+        return true;
+    }
+    if (left != nullptr) {
+        MoveEntries(leaf, 0, leaf->n, left, left->n);
+        left->n += leaf->n;
+        Unlink(leaf);
+        delete leaf;
+        RemoveChild(p, s - 1);
+    } else {
+        MoveEntries(right, 0, right->n, leaf, leaf->n);
+        leaf->n += right->n;
+        Unlink(right);
+        delete right;
+        RemoveChild(p, s);
+    }
+
+    // The parent lost a child; fix up the inner nodes the same way.
+    for (int d = depth - 1; ; d--) {
+        Inner *x = path[d];
+        if (d == 0) {
+            if (x->n == 0) {
+                root_ = x->child[0];
+                delete x;
+            }
+            return true;
+        }
+        if (x->n >= MIN)
+            return true;
+
+        p = path[d - 1], s = slot[d - 1];
+        Inner *l = s > 0 ? static_cast<Inner*>(p->child[s - 1]) : nullptr;
+        Inner *r = s < p->n ? static_cast<Inner*>(p->child[s + 1]) : nullptr;
+        if (l != nullptr && l->n > MIN) {
+            // rotate the last child of l over through the parent
+            std::move_backward(x->keys, x->keys + x->n, x->keys + x->n + 1);
+            std::move_backward(x->child, x->child + x->n + 1, x->child + x->n + 2);
+            x->keys[0] = std::move(p->keys[s - 1]);
+            x->child[0] = l->child[l->n];
+            p->keys[s - 1] = std::move(l->keys[l->n - 1]);
+            ++x->n, --l->n;
+            return true;
+        }
+        if (r != nullptr && r->n > MIN) {
+            x->keys[x->n] = std::move(p->keys[s]);
+            x->child[x->n + 1] = r->child[0];
+            p->keys[s] = std::move(r->keys[0]);
+            std::move(r->keys + 1, r->keys + r->n, r->keys);
+            std::copy(r->child + 1, r->child + r->n + 1, r->child);
+            ++x->n, --r->n;
+            return true;
+        }
+        if (l == nullptr)
+            l = x, x = r, ++s;
+        // merge x into l, pulling their separator down between them
+        l->keys[l->n] = std::move(p->keys[s - 1]);
+        std::move(x->keys, x->keys + x->n, l->keys + l->n + 1);
+        std::copy(x->child, x->child + x->n + 1, l->child + l->n + 1);
+        l->n += x->n + 1;
+        delete x;
+        RemoveChild(p, s - 1);
+    }
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::Search(const Key &key) const
+{
+    Iterator it = LowerBound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::LowerBound(const Key &key) const
+{
+    if (root_ == nullptr)
+        return end();
+    Node *x = root_;
+    while (!x->leaf) {
+        const Inner *in = static_cast<const Inner*>(x);
+        x = in->child[Find(in->keys, in->n, key)];
+    }
+    Leaf *leaf = static_cast<Leaf*>(x);
+    const int i = Find(leaf->keys, leaf->n, key);
+    // past the last key of the leaf, the answer opens the next one
+    if (i == leaf->n)
+        return Iterator(this, leaf->next, 0);
+    return Iterator(this, leaf, i);
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::UpperBound(const Key &key) const
+{
+    Iterator it = LowerBound(key);
+    if (it != end() && !comp_(key, *it))
+        ++it;
+    return it;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::Minimum() const
+{
+    return begin();
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::Maximum() const
+{
+    return tail_ != nullptr ? Iterator(this, tail_, tail_->n - 1) : end();
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::Successor(Iterator it) const
+{
+    return ++it;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::Predecessor(Iterator it) const
+{
+    return it == begin() ? end() : --it;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::begin() const
+{
+    return Iterator(this, head_, 0);
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Iterator
+BPlusTree<Key, Value, Compare, B>::end() const
+{
+    return Iterator(this, nullptr, 0);
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+size_t BPlusTree<Key, Value, Compare, B>::size() const
+{
+    return size_;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+bool BPlusTree<Key, Value, Compare, B>::empty() const
+{
+    return size_ == 0;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+void BPlusTree<Key, Value, Compare, B>::Clear()
+{
+    if (root_ != nullptr)
+        Free(root_);
+    root_ = head_ = tail_ = nullptr;
+    size_ = 0;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+BPlusTree<Key, Value, Compare, B>::~BPlusTree()
+{
+    Clear();
+}
+
+//
+// Walks down to the leaf where key belongs, recording the inner nodes on
+// the way and the child taken at each.
+//
+template<typename Key, typename Value, typename Compare, int B>
+typename BPlusTree<Key, Value, Compare, B>::Leaf*
+BPlusTree<Key, Value, Compare, B>::Descend(const Key &key, Inner **path, int *slot,
+                                           int &depth) const
+{
+    Node *x = root_;
+    while (!x->leaf) {
+        Inner *in = static_cast<Inner*>(x);
+        const int i = Find(in->keys, in->n, key);
+        path[depth] = in;
+        slot[depth++] = i;
+        x = in->child[i];
+    }
+    return static_cast<Leaf*>(x);
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+template<typename... Args>
+void BPlusTree<Key, Value, Compare, B>::InsertAt(Leaf *leaf, int i, const Key &key,
+                                                 Args&&... value)
+{
+    std::move_backward(leaf->keys + i, leaf->keys + leaf->n, leaf->keys + leaf->n + 1);
+    leaf->keys[i] = key;
+    if constexpr (IS_MAP) {
+        std::move_backward(leaf->values + i, leaf->values + leaf->n, leaf->values + leaf->n + 1);
+        leaf->values[i] = Value(std::forward<Args>(value)...);
+    }
+    ++leaf->n;
+}
+
+//
+// Moves the entries [first, last) of one leaf to position at of another, or
+// of the same one, either way; the counts are left to the caller.
+//
+template<typename Key, typename Value, typename Compare, int B>
+void BPlusTree<Key, Value, Compare, B>::MoveEntries(Leaf *from, int first, int last,
+                                                    Leaf *to, int at)
+{
+    if (from == to && at > first) {
+        std::move_backward(from->keys + first, from->keys + last, to->keys + at + (last - first));
+        if constexpr (IS_MAP)
+            std::move_backward(from->values + first, from->values + last,
+                               to->values + at + (last - first));
+    } else {
+        std::move(from->keys + first, from->keys + last, to->keys + at);
+        if constexpr (IS_MAP)
+            std::move(from->values + first, from->values + last, to->values + at);
+    }
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+void BPlusTree<Key, Value, Compare, B>::RemoveChild(Inner *x, int i)
+{
+    std::move(x->keys + i + 1, x->keys + x->n, x->keys + i);
+    std::copy(x->child + i + 2, x->child + x->n + 1, x->child + i + 1);
+    --x->n;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+void BPlusTree<Key, Value, Compare, B>::Unlink(Leaf *leaf)
+{
+    (leaf->prev != nullptr ? leaf->prev->next : head_) = leaf->next;
+    (leaf->next != nullptr ? leaf->next->prev : tail_) = leaf->prev;
+}
+
+template<typename Key, typename Value, typename Compare, int B>
+void BPlusTree<Key, Value, Compare, B>::Free(Node *x)
+{
+    if (x->leaf) {
+        delete static_cast<Leaf*>(x);
+        return;
+    }
+    Inner *in = static_cast<Inner*>(x);
+    for (int i = 0; i <= in->n; i++)
+        Free(in->child[i]);
+    delete in;
+}
+
+#endif  /* BPlusTree_hpp */
@@ -0,0 +1,564 @@
+#ifndef CompactRbTree_hpp
+#define CompactRbTree_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
+
+//
+// A red-black multiset with smaller nodes than RbTree, for small keys. The
+// color lives in bit 0 of the parent link instead of a byte of its own,
+// which padding turns into a whole word. With Indexed set, which is the
+// default, the links are 32-bit indices into one array of nodes rather than
+// pointers: an int key then takes a 16-byte node instead of RbNode's 32,
+// and a uint64_t key 24 bytes instead of 40. The tree then holds up to
+// 2^31 - 1 keys. Otherwise nodes come from a NodePool and links are
+// pointers, which saves the color word only when it is not padding for the
+// key anyway: 32 bytes instead of 40 for uint64_t keys, and no saving for
+// int keys.
+//
+// Each tree has its own sentinel. The CLRS algorithms are RbTree's, and so is
+// Search's use of operator!= to spot the key on the way down.
+//
+// Unlike RbTree's nodes, Indexed nodes move: the array reallocates as it
+// grows, and erased slots are reused. The key pointers that Search,
+// LowerBound, Minimum and Maximum return are then valid only until the next
+// Insert, Erase or Clear. Otherwise they stay valid until their own key is
+// erased, as with RbTree.
+//
+template<typename T, typename Compare = std::less<T>, bool Indexed = true>
+class CompactRbTree {
+    using Link = typename std::conditional<Indexed, std::uint32_t, std::uintptr_t>::type;
+
+    struct Node {
+        Link left;
+        Link right;
+        Link parentColor;  // the parent, shifted when Indexed, and bit 0 set if red
+        T key;
+    };
+
+public:
+    using value_type = T;
+
+    static constexpr std::size_t NODE_BYTES = sizeof(Node);
+
+    explicit CompactRbTree(const Compare &comp = Compare());
+    CompactRbTree(const CompactRbTree&) = delete;
+    CompactRbTree& operator=(const CompactRbTree&) = delete;
+    ~CompactRbTree();
+
+    //
+    // Inserts key, even if it is already present.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void Insert(T key);
+
+    //
+    // Erases one occurrence of key, returning whether there was any.
+    //
+    // Time Complexity: O(lg n)
+    //
+    bool Erase(const T &key);
+
+    //
+    // The key pointers below are invalidated by the next Insert, Erase or
+    // Clear when Indexed.
+    //
+
+    // A key equal to key, or nullptr.
+    const T* Search(const T &key) const;
+
+    // The first key not ordered before key, or nullptr.
+    const T* LowerBound(const T &key) const;
+
+    const T* Minimum() const;
+    const T* Maximum() const;
+
+    //
+    // Calls visit(key) for every key in order.
+    //
+    template<typename F>
+    void ForEach(F visit) const;
+
+    std::size_t Size() const;
+    void Clear();
+
+    // Whether the tree satisfies the red-black properties, for testing.
+    bool IsValid() const;
+
+private:
+    static constexpr Link RED = 1;
+    static constexpr std::size_t MAX_NODES = static_cast<Link>(-1) >> 1;
+
+    Node nil {};                // the sentinel when not Indexed
+    std::vector<Node> nodes;    // the nodes when Indexed, nodes[0] the sentinel
+    Link freeList {0};          // erased slots of nodes, chained through left
+    NodePool<Node> pool;        // the nodes when not Indexed
+    Link NIL;
+    Link root;
+    std::size_t size {0};
+    Compare comp;
+
+    Node& N(Link x)
+    {
+        if constexpr (Indexed)
+            return nodes[x];
+        else
+            return *reinterpret_cast<Node*>(x);
+    }
+
+    const Node& N(Link x) const
+    {
+        if constexpr (Indexed)
+            return nodes[x];
+        else
+            return *reinterpret_cast<const Node*>(x);
+    }
+
+    static Link Pack(Link parent)
+    {
+        return Indexed ? parent << 1 : parent;
+    }
+
+    Link Parent(Link x) const
+    {
+        return Indexed ? N(x).parentColor >> 1 : N(x).parentColor & ~RED;
+    }
+
+    bool IsRed(Link x) const
+    {
+        return N(x).parentColor & RED;
+    }
+
+    void SetParent(Link x, Link parent)
+    {
+        N(x).parentColor = Pack(parent) | (N(x).parentColor & RED);
+    }
+
+    void SetRed(Link x, bool red)
+    {
+        N(x).parentColor = (N(x).parentColor & ~RED) | static_cast<Link>(red);
+    }
+
+    Link NewNode(T &&key);
+    void FreeNode(Link x);
+    Link Find(const T &key) const;
+    Link MinimumOf(Link x) const;
+    void LeftRotate(Link x);
+    void RightRotate(Link x);
+    void InsertFixUp(Link z);
+    void Transplant(Link u, Link v);
+    void Delete(Link z);
+    void DeleteFixUp(Link x);
+    template<typename F>
+    void Walk(Link x, F &visit) const;
+    int BlackHeight(Link x) const;
+};
+
+template<typename T, typename Compare, bool Indexed>
+CompactRbTree<T, Compare, Indexed>::CompactRbTree(const Compare &comp)
+: comp(comp)
+{
+    if constexpr (Indexed) {
+        nodes.emplace_back();
+        NIL = 0;
+    } else {
+        NIL = reinterpret_cast<Link>(&nil);
+    }
+    root = NIL;
+}
+
+template<typename T, typename Compare, bool Indexed>
+CompactRbTree<T, Compare, Indexed>::~CompactRbTree()
+{
+    if constexpr (!Indexed)
+        Clear();
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::Insert(T key)
+{
+    const Link z = NewNode(std::move(key));
+    Link y = NIL;
+    for (Link x = root; x != NIL; x = comp(N(z).key, N(x).key) ? N(x).left : N(x).right)
+        y = x;
+    N(z).left = N(z).right = NIL;
+    N(z).parentColor = Pack(y) | RED;
+    if (y == NIL)
+        root = z;
+    else if (comp(N(z).key, N(y).key))
+        N(y).left = z;
+    else
+        N(y).right = z;
+    InsertFixUp(z);
+    ++size;
+}
+
+template<typename T, typename Compare, bool Indexed>
+bool CompactRbTree<T, Compare, Indexed>::Erase(const T &key)
+{
+    const Link z = Find(key);
+    if (z == NIL)
+        return false;
+    Delete(z);
+    FreeNode(z);
+    --size;
+    return true;
+}
+
+template<typename T, typename Compare, bool Indexed>
+const T* CompactRbTree<T, Compare, Indexed>::Search(const T &key) const
+{
+    const Link x = Find(key);
+    return x == NIL ? nullptr : &N(x).key;
+}
+
+template<typename T, typename Compare, bool Indexed>
+const T* CompactRbTree<T, Compare, Indexed>::LowerBound(const T &key) const
+{
+    Link best = NIL;
+    for (Link x = root; x != NIL; ) {
+        const bool before = comp(N(x).key, key);
+        best = before ? best : x;
+        x = before ? N(x).right : N(x).left;
+    }
+    return best == NIL ? nullptr : &N(best).key;
+}
+
+template<typename T, typename Compare, bool Indexed>
+const T* CompactRbTree<T, Compare, Indexed>::Minimum() const
+{
+    return root == NIL ? nullptr : &N(MinimumOf(root)).key;
+}
+
+template<typename T, typename Compare, bool Indexed>
+const T* CompactRbTree<T, Compare, Indexed>::Maximum() const
+{
+    if (root == NIL)
+        return nullptr;
+    Link x = root;
+    while (N(x).right != NIL)
+        x = N(x).right;
+    return &N(x).key;
+}
+
+template<typename T, typename Compare, bool Indexed>
+template<typename F>
+void CompactRbTree<T, Compare, Indexed>::ForEach(F visit) const
+{
+    Walk(root, visit);
+}
+
+template<typename T, typename Compare, bool Indexed>
+std::size_t CompactRbTree<T, Compare, Indexed>::Size() const
+{
+    return size;
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::Clear()
+{
+    if constexpr (Indexed) {
+        nodes.resize(1);
+        freeList = 0;
+    } else if (std::is_trivially_destructible<T>::value) {
+        pool = NodePool<Node>();
+    } else {
+        std::vector<Link> stack {root};
+        while (!stack.empty()) {
+            const Link x = stack.back();
+            stack.pop_back();
+            if (x == NIL)
+                continue;
+            stack.push_back(N(x).left);
+            stack.push_back(N(x).right);
+            FreeNode(x);
+        }
+    }
+    root = NIL;
+    size = 0;
+}
+
+template<typename T, typename Compare, bool Indexed>
+bool CompactRbTree<T, Compare, Indexed>::IsValid() const
+{
+    return !IsRed(root) && !IsRed(NIL) && BlackHeight(root) >= 0;
+}
+
+template<typename T, typename Compare, bool Indexed>
+typename CompactRbTree<T, Compare, Indexed>::Link
+CompactRbTree<T, Compare, Indexed>::NewNode(T &&key)
+{
+    if constexpr (Indexed) {
+        if (freeList != 0) {
+            const Link x = freeList;
+            freeList = nodes[x].left;
+            nodes[x].key = std::move(key);
+            return x;
+        }
+        if (nodes.size() > MAX_NODES)
+            throw new std::length_error("Too many keys for 32-bit node indices.");
+        nodes.push_back(Node{0, 0, 0, std::move(key)});
+        return static_cast<Link>(nodes.size() - 1);
+    } else {
+        return reinterpret_cast<Link>(pool.New(Node{0, 0, 0, std::move(key)}));
+    }
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::FreeNode(Link x)
+{
+    if constexpr (Indexed) {
+        if (!std::is_trivially_destructible<T>::value)
+            nodes[x].key = T{};  // release what the key holds now
+        nodes[x].left = freeList;
+        freeList = x;
+    } else {
+        pool.Delete(&N(x));
+    }
+}
+
+template<typename T, typename Compare, bool Indexed>
+typename CompactRbTree<T, Compare, Indexed>::Link
+CompactRbTree<T, Compare, Indexed>::Find(const T &key) const
+{
+    Link x = root;
+    while (x != NIL && N(x).key != key)
+        x = comp(key, N(x).key) ? N(x).left : N(x).right;
+    return x;
+}
+
+template<typename T, typename Compare, bool Indexed>
+typename CompactRbTree<T, Compare, Indexed>::Link
+CompactRbTree<T, Compare, Indexed>::MinimumOf(Link x) const
+{
+    while (N(x).left != NIL)
+        x = N(x).left;
+    return x;
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::LeftRotate(Link x)
+{
+    const Link y = N(x).right;
+    N(x).right = N(y).left;
+    if (N(y).left != NIL)
+        SetParent(N(y).left, x);
+    const Link p = Parent(x);
+    SetParent(y, p);
+    if (p == NIL)
+        root = y;
+    else if (x == N(p).left)
+        N(p).left = y;
+    else
+        N(p).right = y;
+    N(y).left = x;
+    SetParent(x, y);
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::RightRotate(Link x)
+{
+    const Link y = N(x).left;
+    N(x).left = N(y).right;
+    if (N(y).right != NIL)
+        SetParent(N(y).right, x);
+    const Link p = Parent(x);
+    SetParent(y, p);
+    if (p == NIL)
+        root = y;
+    else if (x == N(p).left)
+        N(p).left = y;
+    else
+        N(p).right = y;
+    N(y).right = x;
+    SetParent(x, y);
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::InsertFixUp(Link z)
+{
+    while (IsRed(Parent(z))) {
+        Link p = Parent(z);
+        const Link g = Parent(p);
+        if (p == N(g).left) {
+            const Link y = N(g).right;
+            if (IsRed(y)) {
+                SetRed(p, false);
+                SetRed(y, false);
+                SetRed(g, true);
+                z = g;
+            } else {
+                if (z == N(p).right) {
+                    z = p;
+                    LeftRotate(z);
+                    p = Parent(z);
+                }
+                SetRed(p, false);
+                SetRed(g, true);
+                RightRotate(g);
+            }
+        } else {
+            const Link y = N(g).left;
+            if (IsRed(y)) {
+                SetRed(p, false);
+                SetRed(y, false);
+                SetRed(g, true);
+                z = g;
+            } else {
+                if (z == N(p).left) {
+                    z = p;
+                    RightRotate(z);
+                    p = Parent(z);
+                }
+                SetRed(p, false);
+                SetRed(g, true);
+                LeftRotate(g);
+            }
+        }
+    }
+    SetRed(root, false);
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::Transplant(Link u, Link v)
+{
+    const Link p = Parent(u);
+    if (p == NIL)
+        root = v;
+    else if (u == N(p).left)
+        N(p).left = v;
+    else
+        N(p).right = v;
+    SetParent(v, p);
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::Delete(Link z)
+{
+    Link x;
+    Link y = z;
+    bool yOriginallyRed = IsRed(y);
+    if (N(z).left == NIL) {
+        x = N(z).right;
+        Transplant(z, x);
+    } else if (N(z).right == NIL) {
+        x = N(z).left;
+        Transplant(z, x);
+    } else {
+        y = MinimumOf(N(z).right);
+        yOriginallyRed = IsRed(y);
+        x = N(y).right;
+        if (Parent(y) == z) {
+            SetParent(x, y);
+        } else {
+            Transplant(y, N(y).right);
+            N(y).right = N(z).right;
+            SetParent(N(y).right, y);
+        }
+        Transplant(z, y);
+        N(y).left = N(z).left;
+        SetParent(N(y).left, y);
+        SetRed(y, IsRed(z));
+    }
+    if (!yOriginallyRed)
+        DeleteFixUp(x);
+}
+
+template<typename T, typename Compare, bool Indexed>
+void CompactRbTree<T, Compare, Indexed>::DeleteFixUp(Link x)
+{
+    while (x != root && !IsRed(x)) {
+        const Link p = Parent(x);
+        if (x == N(p).left) {
+            Link w = N(p).right;
+            if (IsRed(w)) {
+                SetRed(w, false);
+                SetRed(p, true);
+                LeftRotate(p);
+                w = N(p).right;
+            }
+            if (!IsRed(N(w).left) && !IsRed(N(w).right)) {
+                SetRed(w, true);
+                x = p;
+            } else {
+                if (!IsRed(N(w).right)) {
+                    SetRed(N(w).left, false);
+                    SetRed(w, true);
+                    RightRotate(w);
+                    w = N(p).right;
+                }
+                SetRed(w, IsRed(p));
+                SetRed(p, false);
+                SetRed(N(w).right, false);
+                LeftRotate(p);
+                x = root;
+            }
+        } else {
+            Link w = N(p).left;
+            if (IsRed(w)) {
+                SetRed(w, false);
+                SetRed(p, true);
+                RightRotate(p);
+                w = N(p).left;
+            }
+            if (!IsRed(N(w).right) && !IsRed(N(w).left)) {
+                SetRed(w, true);
+                x = p;
+            } else {
+                if (!IsRed(N(w).left)) {
+                    SetRed(N(w).right, false);
+                    SetRed(w, true);
+                    LeftRotate(w);
+                    w = N(p).left;
+                }
+                SetRed(w, IsRed(p));
+                SetRed(p, false);
+                SetRed(N(w).left, false);
+                RightRotate(p);
+                x = root;
+            }
+        }
+    }
+    SetRed(x, false);
+}
+
+template<typename T, typename Compare, bool Indexed>
+template<typename F>
+void CompactRbTree<T, Compare, Indexed>::Walk(Link x, F &visit) const
+{
+    if (x == NIL)
+        return;
+    Walk(N(x).left, visit);
+    visit(N(x).key);
+    Walk(N(x).right, visit);
+}
+
+//
+// The black height of x, or -1 if a red node has a red child, the keys are
+// out of order or some paths differ in black nodes.
+//
+template<typename T, typename Compare, bool Indexed>
+int CompactRbTree<T, Compare, Indexed>::BlackHeight(Link x) const
+{
+    if (x == NIL)
+        return 0;
+    const Link l = N(x).left, r = N(x).right;
+    if (IsRed(x) && (IsRed(l) || IsRed(r)))
+        return -1;
+    if ((l != NIL && (comp(N(x).key, N(l).key) || Parent(l) != x)) ||
+        (r != NIL && (comp(N(r).key, N(x).key) || Parent(r) != x)))
+        return -1;
+    const int hl = BlackHeight(l), hr = BlackHeight(r);
+    if (hl < 0 || hl != hr)
+        return -1;
+    return hl + !IsRed(x);
+}
+
+#endif  /* CompactRbTree_hpp */
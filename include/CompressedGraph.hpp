@@ -0,0 +1,175 @@
+#ifndef CompressedGraph_hpp
+#define CompressedGraph_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "Parallel.hpp"
+
+//
+// A read-only, compressed adjacency representation for very large graphs.
+//
+// The neighbors of every vertex are sorted by id and stored as a byte stream
+// of LEB128 varints: the first destination as a zigzag-encoded offset from
+// the source vertex, each following one as the (non-negative) gap to its
+// predecessor, each followed by its zigzag-encoded weight. Since sorted
+// neighbor ids tend to be close together, most gaps fit in one byte, so an
+// edge typically costs 2-3 bytes instead of the 8 of a std::pair<int, int>.
+// A vertex costs 8 bytes for the offset of its stream.
+//
+// Edges are decoded on the fly by a forward NeighborIterator, so anything
+// written against the V()/Neighbors(v) interface (see GraphAlgorithms.hpp)
+// runs on a CompressedGraph without ever materializing its adjacency lists.
+//
+class CompressedGraph {
+public:
+    class NeighborIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<int, int>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        NeighborIterator() = default;
+        NeighborIterator(const std::uint8_t *at, const std::uint8_t *end, int src)
+        : at_{at}, next_{at}, end_{end}, cur_{src, 0}
+        {
+            Decode();
+        }
+        // LegacyInputIterator Requirements
+        NeighborIterator& operator++()
+        {
+            at_ = next_;
+            Decode();
+            return *this;
+        }
+        NeighborIterator operator++(int)
+        {
+            NeighborIterator copy(*this);
+            ++*this;
+            return copy;
+        }
+        bool operator==(const NeighborIterator &it) const
+        {
+            return at_ == it.at_;
+        }
+        bool operator!=(const NeighborIterator &it) const
+        {
+            return !(*this == it);
+        }
+        const std::pair<int, int>& operator*() const
+        {
+            return cur_;
+        }
+        const std::pair<int, int>* operator->() const
+        {
+            return &cur_;
+        }
+
+    private:
+        const std::uint8_t *at_ {nullptr};    // start of the current edge
+        const std::uint8_t *next_ {nullptr};  // start of the following edge
+        const std::uint8_t *end_ {nullptr};
+        std::pair<int, int> cur_ {0, 0};      // decoded (destination, weight)
+        bool first_ {true};
+
+        void Decode();
+    };
+
+    class NeighborRange {
+    public:
+        NeighborRange(const std::uint8_t *first, const std::uint8_t *last, int src)
+        : first_{first}, last_{last}, src_{src} {}
+
+        NeighborIterator begin() const
+        {
+            return NeighborIterator(first_, last_, src_);
+        }
+        NeighborIterator end() const
+        {
+            return NeighborIterator(last_, last_, src_);
+        }
+        bool empty() const
+        {
+            return first_ == last_;
+        }
+
+    private:
+        const std::uint8_t *first_, *last_;
+        int src_;
+    };
+
+    //
+    // Encodes any graph exposing V() and Neighbors(v), one chunk of vertices
+    // per task across `numThreads` threads (all hardware threads by default).
+    //
+    // Time Complexity: O(E lg d) for maximum degree d
+    //
+    template<typename G>
+    explicit CompressedGraph(const G &g, int numThreads = 0);
+
+    int V() const;
+
+    //
+    // Returns a range decoding the (destination, weight) pairs of the edges
+    // leaving v in ascending order of destination.
+    //
+    NeighborRange Neighbors(int v) const;
+
+    //
+    // Returns the number of bytes held by the representation.
+    //
+    std::size_t MemoryUsage() const;
+
+    std::vector<int> PrimAlgorithm() const;
+    std::vector<int> BFS(int src) const;
+
+private:
+    int V_;
+    std::vector<std::uint64_t> offset_;  // stream of v is bytes_[offset_[v] .. offset_[v + 1])
+    std::vector<std::uint8_t> bytes_;
+
+    static void Encode(int src, std::vector<std::pair<int, int>> &nbrs,
+                       std::vector<std::uint8_t> &out);
+};
+
+template<typename G>
+CompressedGraph::CompressedGraph(const G &g, int numThreads)
+: V_{g.V()}, offset_(g.V() + 1, 0)
+{
+    // Encode chunks of vertices into separate buffers, then stitch them.
+    const std::size_t GRAIN = 1024;
+    std::vector<std::vector<std::uint8_t>> chunks ((V_ + GRAIN - 1) / GRAIN);
+    ParallelFor(chunks.size(), numThreads, 1, [&](int, std::size_t first, std::size_t last) {
+        std::vector<std::pair<int, int>> nbrs;
+        for (std::size_t c = first; c < last; c++) {
+            const std::size_t vlast = std::min<std::size_t>(V_, (c + 1) * GRAIN);
+            for (std::size_t v = c * GRAIN; v < vlast; v++) {
+                nbrs.clear();
+                for (std::pair<int, int> edge : g.Neighbors(v))
+                    nbrs.push_back(edge);
+                Encode(v, nbrs, chunks[c]);
+                offset_[v + 1] = chunks[c].size();  // relative to the chunk for now
+            }
+        }
+    });
+    std::vector<std::uint64_t> chunkStart (chunks.size() + 1, 0);
+    for (std::size_t c = 0; c < chunks.size(); c++)
+        chunkStart[c + 1] = chunkStart[c] + chunks[c].size();
+    bytes_.resize(chunkStart.back());
+    ParallelFor(chunks.size(), numThreads, 1, [&](int, std::size_t first, std::size_t last) {
+        for (std::size_t c = first; c < last; c++) {
+            std::copy(chunks[c].begin(), chunks[c].end(), bytes_.begin() + chunkStart[c]);
+            std::vector<std::uint8_t>().swap(chunks[c]);
+            const std::size_t vlast = std::min<std::size_t>(V_, (c + 1) * GRAIN);
+            for (std::size_t v = c * GRAIN; v < vlast; v++)
+                offset_[v + 1] += chunkStart[c];
+        }
+    });
+}
+
+#endif  /* CompressedGraph_hpp */
@@ -0,0 +1,504 @@
+#ifndef ConcurrentOrderedSet_hpp
+#define ConcurrentOrderedSet_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "RbTree.hpp"  // Color
+
+//
+// A red-black tree set that many threads can read while others update it,
+// for read-mostly workloads.
+//
+// A published node is never modified. An update copies the O(lg n) nodes on
+// the path it changes, as PersistentRbTree does, and publishes the new
+// version with a single release store of the root. Readers load the root
+// and walk whichever version they got: they take no lock, never wait for a
+// writer and never retry, so lookups are wait-free. Insertion rebalances as
+// in Okasaki's functional red-black trees, deletion as in Kahrs'.
+//
+// The nodes an update replaces are not freed immediately. They are retired,
+// and freed in batches once every reader that might still hold an older
+// root has finished, RCU style. Each reader counts itself in one of two
+// generations of striped counters. Once a batch has piled up, the writer
+// flips the generation if the readers of the one before have all left,
+// and frees the batch retired before the previous flip. It never waits for
+// them: if some are still there, it tries again after the next update.
+//
+// Updates are serialized on one lock, each building on the version the
+// last one published. Only writers wait on it; no reader is ever delayed
+// by a writer.
+//
+template<typename T, typename Compare = std::less<T>>
+class ConcurrentOrderedSet {
+    struct Node {
+        T key;
+        Color color;
+        Node *left;
+        Node *right;
+        std::uint64_t version;  // the update that created the node
+    };
+
+public:
+    explicit ConcurrentOrderedSet(const Compare &comp = Compare()) : comp(comp) {}
+    ConcurrentOrderedSet(const ConcurrentOrderedSet&) = delete;
+    ConcurrentOrderedSet& operator=(const ConcurrentOrderedSet&) = delete;
+    ~ConcurrentOrderedSet();
+
+    //
+    // Inserts key unless it is present, returning whether it was inserted.
+    //
+    // Time Complexity: O(lg n), copying O(lg n) nodes, serialized with the
+    // other updates
+    //
+    bool Insert(const T &key);
+
+    //
+    // Erases key, returning whether it was present.
+    //
+    // Time Complexity: O(lg n) amortized, copying O(lg n) nodes, serialized
+    // with the other updates
+    //
+    bool Erase(const T &key);
+
+    //
+    // Time Complexity: O(lg n), wait-free
+    //
+    bool Contains(const T &key) const;
+
+    //
+    // Copies the first key not ordered before key to out, returning false if
+    // there is none.
+    //
+    // Time Complexity: O(lg n), wait-free
+    //
+    bool LowerBound(const T &key, T &out) const;
+
+    std::size_t Size() const;
+
+private:
+    // Striped reader counters; a thread always uses the same stripe.
+    static constexpr int STRIPES = 32;
+    // Replaced nodes are freed about this many at a time.
+    static constexpr std::size_t RECLAIM_BATCH = 1024;
+
+    struct alignas(64) ReaderCount {
+        std::atomic<long> n {0};
+    };
+
+    // Counts a reader in the current generation for its lifetime.
+    class ReadGuard {
+        std::atomic<long> *count;
+    public:
+        explicit ReadGuard(const ConcurrentOrderedSet &s)
+        : count(&s.readers[s.generation.load() & 1][Stripe()].n)
+        {
+            count->fetch_add(1);
+            // pairs with the fence in Reclaim: either the writer sees
+            // this reader, or the reader sees the root that replaced the
+            // retired nodes
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~ReadGuard()
+        {
+            count->fetch_sub(1, std::memory_order_release);
+        }
+    };
+
+    std::atomic<Node*> root {nullptr};
+    Compare comp;
+
+    std::mutex writer;
+    std::uint64_t version {0};  // the update in progress
+    std::atomic<std::size_t> size {0};
+    mutable ReaderCount readers[2][STRIPES];
+    std::atomic<unsigned> generation {0};
+    std::vector<Node*> retired;   // replaced since the last flip
+    std::vector<Node*> retiring;  // replaced before it
+
+    static int Stripe();
+    void Publish(Node *x);
+    void Reclaim();
+
+    static bool IsRed(const Node *x);
+    static bool IsBlack(const Node *x);  // and not a leaf
+    static Node* Set(Color color, Node *left, Node *x, Node *right);
+    Node* Own(Node *x);
+    Node* Reddened(Node *x);
+    Node* Balance(Node *a, Node *x, Node *b);
+    Node* Insert(Node *t, const T &key);
+    Node* BalanceLeft(Node *left, Node *x, Node *right);
+    Node* BalanceRight(Node *left, Node *x, Node *right);
+    Node* Append(Node *a, Node *b);
+    Node* Delete(Node *t, const T &key);
+    void Deallocate(Node *x);
+};
+
+template<typename T, typename Compare>
+ConcurrentOrderedSet<T, Compare>::~ConcurrentOrderedSet()
+{
+    Deallocate(root.load(std::memory_order_relaxed));
+    for (const std::vector<Node*> *nodes : {&retired, &retiring})
+        for (Node *x : *nodes)
+            delete x;
+}
+
+template<typename T, typename Compare>
+bool ConcurrentOrderedSet<T, Compare>::Insert(const T &key)
+{
+    std::lock_guard<std::mutex> lock(writer);
+    if (Contains(key))
+        return false;
+    ++version;
+    Node *x = Insert(root.load(std::memory_order_relaxed), key);
+    x->color = Color::BLACK;
+    Publish(x);
+    size.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename T, typename Compare>
+bool ConcurrentOrderedSet<T, Compare>::Erase(const T &key)
+{
+    std::lock_guard<std::mutex> lock(writer);
+    if (!Contains(key))
+        return false;
+    ++version;
+    Node *x = Delete(root.load(std::memory_order_relaxed), key);
+    if (IsRed(x)) {
+        x = Own(x);
+        x->color = Color::BLACK;
+    }
+    Publish(x);
+    size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename T, typename Compare>
+bool ConcurrentOrderedSet<T, Compare>::Contains(const T &key) const
+{
+    ReadGuard guard(*this);
+    for (const Node *x = root.load(std::memory_order_acquire); x != nullptr; ) {
+        if (comp(key, x->key))
+            x = x->left;
+        else if (comp(x->key, key))
+            x = x->right;
+        else
+            return true;
+    }
+    return false;
+}
+
+template<typename T, typename Compare>
+bool ConcurrentOrderedSet<T, Compare>::LowerBound(const T &key, T &out) const
+{
+    ReadGuard guard(*this);
+    const Node *best = nullptr;
+    for (const Node *x = root.load(std::memory_order_acquire); x != nullptr; ) {
+        if (!comp(x->key, key)) {
+            best = x;
+            x = x->left;
+        } else {
+            x = x->right;
+        }
+    }
+    if (best == nullptr)
+        return false;
+    out = best->key;
+    return true;
+}
+
+template<typename T, typename Compare>
+std::size_t ConcurrentOrderedSet<T, Compare>::Size() const
+{
+    return size.load(std::memory_order_relaxed);
+}
+
+template<typename T, typename Compare>
+int ConcurrentOrderedSet<T, Compare>::Stripe()
+{
+    static std::atomic<unsigned> next {0};
+    thread_local const int stripe = next.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+    return stripe;
+}
+
+//
+// Makes the fully built version rooted at x the one readers find, and
+// frees the replaced nodes once enough of them have piled up.
+//
+template<typename T, typename Compare>
+void ConcurrentOrderedSet<T, Compare>::Publish(Node *x)
+{
+    root.store(x, std::memory_order_release);
+    if (retired.size() >= RECLAIM_BATCH)
+        Reclaim();
+}
+
+//
+// Flips the generation if no reader is left in the one before the current
+// one, and then frees the nodes retired before the previous flip. A reader
+// counted in that generation has left, and any other reader started after
+// those nodes were replaced: it read a generation the previous flip set,
+// or it counted itself in the checked generation too late to be seen, and
+// then its fence ordered its load of the root after that check.
+//
+template<typename T, typename Compare>
+void ConcurrentOrderedSet<T, Compare>::Reclaim()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const unsigned current = generation.load(std::memory_order_relaxed);
+    for (ReaderCount &count : readers[(current + 1) & 1])
+        if (count.n.load(std::memory_order_acquire) != 0)
+            return;
+    generation.store(current + 1);
+    for (Node *x : retiring)
+        delete x;
+    retiring.swap(retired);
+    retired.clear();
+}
+
+template<typename T, typename Compare>
+bool ConcurrentOrderedSet<T, Compare>::IsRed(const Node *x)
+{
+    return x != nullptr && x->color == Color::RED;
+}
+
+template<typename T, typename Compare>
+bool ConcurrentOrderedSet<T, Compare>::IsBlack(const Node *x)
+{
+    return x != nullptr && x->color == Color::BLACK;
+}
+
+// Relinks and recolors x, which the update owns, and returns it.
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Set(Color color, Node *left, Node *x, Node *right)
+{
+    x->color = color;
+    x->left = left;
+    x->right = right;
+    return x;
+}
+
+//
+// A node the update may modify in place of x: x itself if the update
+// created it, or else a copy, x being retired. Readers may be walking x,
+// so it must be owned before it is relinked or recolored, and only once.
+//
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Own(Node *x)
+{
+    if (x->version == version)
+        return x;
+    retired.push_back(x);
+    return new Node{x->key, x->color, x->left, x->right, version};
+}
+
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Reddened(Node *x)
+{
+    if (!IsBlack(x))
+        throw new std::logic_error("Red-black invariant violated.");
+    x = Own(x);
+    x->color = Color::RED;
+    return x;
+}
+
+//
+// Links a and b under the owned node x, black, rotating into a red node
+// with two black children when it would have a red child with a red child.
+//
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Balance(Node *a, Node *x, Node *b)
+{
+    if (IsRed(a) && IsRed(b)) {
+        a = Own(a);
+        b = Own(b);
+        a->color = b->color = Color::BLACK;
+        return Set(Color::RED, a, x, b);
+    }
+    if (IsRed(a) && IsRed(a->left)) {
+        a = Own(a);
+        Node *c = Own(a->left);
+        c->color = Color::BLACK;
+        Set(Color::BLACK, a->right, x, b);
+        return Set(Color::RED, c, a, x);
+    }
+    if (IsRed(a) && IsRed(a->right)) {
+        a = Own(a);
+        Node *c = Own(a->right);
+        Set(Color::BLACK, a->left, a, c->left);
+        Set(Color::BLACK, c->right, x, b);
+        return Set(Color::RED, a, c, x);
+    }
+    if (IsRed(b) && IsRed(b->right)) {
+        b = Own(b);
+        Node *c = Own(b->right);
+        c->color = Color::BLACK;
+        Set(Color::BLACK, a, x, b->left);
+        return Set(Color::RED, x, b, c);
+    }
+    if (IsRed(b) && IsRed(b->left)) {
+        b = Own(b);
+        Node *c = Own(b->left);
+        Set(Color::BLACK, a, x, c->left);
+        Set(Color::BLACK, c->right, b, b->right);
+        return Set(Color::RED, x, c, b);
+    }
+    return Set(Color::BLACK, a, x, b);
+}
+
+// Inserts the absent key into t; the root may come back red.
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Insert(Node *t, const T &key)
+{
+    if (t == nullptr)
+        return new Node{key, Color::RED, nullptr, nullptr, version};
+    t = Own(t);
+    if (comp(key, t->key)) {
+        Node *left = Insert(t->left, key);
+        return t->color == Color::BLACK ? Balance(left, t, t->right)
+                                        : Set(Color::RED, left, t, t->right);
+    }
+    Node *right = Insert(t->right, key);
+    return t->color == Color::BLACK ? Balance(t->left, t, right)
+                                    : Set(Color::RED, t->left, t, right);
+}
+
+//
+// Rebuilds the owned node x, whose left subtree lost one black level.
+//
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::BalanceLeft(Node *left, Node *x, Node *right)
+{
+    if (IsRed(left)) {
+        left = Own(left);
+        left->color = Color::BLACK;
+        return Set(Color::RED, left, x, right);
+    }
+    if (IsBlack(right))
+        return Balance(left, x, Reddened(right));
+    if (IsRed(right) && IsBlack(right->left)) {
+        right = Own(right);
+        Node *c = Own(right->left);
+        Set(Color::BLACK, left, x, c->left);
+        Node *r = Balance(c->right, right, Reddened(right->right));
+        return Set(Color::RED, x, c, r);
+    }
+    throw new std::logic_error("Red-black invariant violated.");
+}
+
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::BalanceRight(Node *left, Node *x, Node *right)
+{
+    if (IsRed(right)) {
+        right = Own(right);
+        right->color = Color::BLACK;
+        return Set(Color::RED, left, x, right);
+    }
+    if (IsBlack(left))
+        return Balance(Reddened(left), x, right);
+    if (IsRed(left) && IsBlack(left->right)) {
+        left = Own(left);
+        Node *c = Own(left->right);
+        Set(Color::BLACK, c->right, x, right);
+        Node *l = Balance(Reddened(left->left), left, c->left);
+        return Set(Color::RED, l, c, x);
+    }
+    throw new std::logic_error("Red-black invariant violated.");
+}
+
+//
+// Concatenates the subtrees of an erased node, all of a's keys coming
+// before b's.
+//
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Append(Node *a, Node *b)
+{
+    if (a == nullptr)
+        return b;
+    if (b == nullptr)
+        return a;
+    if (IsRed(a) && IsRed(b)) {
+        Node *bc = Append(a->right, b->left);
+        a = Own(a);
+        b = Own(b);
+        if (IsRed(bc)) {
+            bc = Own(bc);
+            Set(Color::RED, a->left, a, bc->left);
+            Set(Color::RED, bc->right, b, b->right);
+            return Set(Color::RED, a, bc, b);
+        }
+        Set(Color::RED, bc, b, b->right);
+        return Set(Color::RED, a->left, a, b);
+    }
+    if (IsBlack(a) && IsBlack(b)) {
+        Node *bc = Append(a->right, b->left);
+        a = Own(a);
+        b = Own(b);
+        if (IsRed(bc)) {
+            bc = Own(bc);
+            Set(Color::BLACK, a->left, a, bc->left);
+            Set(Color::BLACK, bc->right, b, b->right);
+            return Set(Color::RED, a, bc, b);
+        }
+        Set(Color::BLACK, bc, b, b->right);
+        return BalanceLeft(a->left, a, b);
+    }
+    if (IsRed(b)) {
+        Node *left = Append(a, b->left);
+        b = Own(b);
+        return Set(Color::RED, left, b, b->right);
+    }
+    Node *right = Append(a->right, b);
+    a = Own(a);
+    return Set(Color::RED, a->left, a, right);
+}
+
+//
+// Deletes the present key from t, retiring its node. A black t comes back
+// one black level shorter, which its parent rebalances.
+//
+template<typename T, typename Compare>
+typename ConcurrentOrderedSet<T, Compare>::Node*
+ConcurrentOrderedSet<T, Compare>::Delete(Node *t, const T &key)
+{
+    if (comp(key, t->key)) {
+        const bool black = IsBlack(t->left);
+        Node *left = Delete(t->left, key);
+        t = Own(t);
+        return black ? BalanceLeft(left, t, t->right) : Set(Color::RED, left, t, t->right);
+    }
+    if (comp(t->key, key)) {
+        const bool black = IsBlack(t->right);
+        Node *right = Delete(t->right, key);
+        t = Own(t);
+        return black ? BalanceRight(t->left, t, right) : Set(Color::RED, t->left, t, right);
+    }
+    retired.push_back(t);
+    return Append(t->left, t->right);
+}
+
+template<typename T, typename Compare>
+void ConcurrentOrderedSet<T, Compare>::Deallocate(Node *x)
+{
+    if (x == nullptr)
+        return;
+    Deallocate(x->left);
+    Deallocate(x->right);
+    delete x;
+}
+
+#endif  /* ConcurrentOrderedSet_hpp */
@@ -0,0 +1,90 @@
+#ifndef CsrGraph_hpp
+#define CsrGraph_hpp
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+struct Edge {
+    int src;
+    int dest;
+    int weight;
+};
+
+struct CsrOptions {
+    bool undirected {true};  // also store every edge as dest -> src, like Graph::AddEdge
+    bool dedup {false};      // keep only the lightest of parallel edges
+    int numThreads {0};      // 0 selects all hardware threads
+};
+
+//
+// An immutable graph in compressed sparse row form: the (destination, weight)
+// pairs of all edges leaving v lie contiguously in adj_[start_[v] ..
+// start_[v + 1]), sorted by destination and then weight.
+//
+// Unlike building a Graph through repeated AddEdge calls, which grows every
+// neighbor vector one push_back at a time on a single thread, a CsrGraph is
+// built from an unsorted edge list in a few parallel passes:
+//
+//   1. Every thread histograms its slice of the edge list by source bucket
+//      (a contiguous range of vertices); a prefix sum over (bucket, thread)
+//      gives each thread a private region per bucket to scatter into.
+//   2. Each bucket is counting-sorted by source vertex on its own, writing
+//      straight into the final adjacency array, and every neighbor list is
+//      sorted (and deduplicated if requested).
+//   3. If deduplication shrank any list, the buckets are compacted.
+//
+// All passes are linear apart from the per-vertex sorts, and no step needs
+// atomics or locks.
+//
+class CsrGraph {
+public:
+    class NeighborRange {
+    public:
+        NeighborRange(const std::pair<int, int> *first, const std::pair<int, int> *last)
+        : first_{first}, last_{last} {}
+
+        const std::pair<int, int>* begin() const
+        {
+            return first_;
+        }
+        const std::pair<int, int>* end() const
+        {
+            return last_;
+        }
+        std::size_t size() const
+        {
+            return last_ - first_;
+        }
+        bool empty() const
+        {
+            return first_ == last_;
+        }
+
+    private:
+        const std::pair<int, int> *first_, *last_;
+    };
+
+    //
+    // Builds the graph on vertices [0, V) from an edge list in any order.
+    //
+    // Time Complexity: O(V + E lg d) work for maximum degree d, spread over
+    // the worker threads
+    //
+    CsrGraph(int V, const std::vector<Edge> &edges, const CsrOptions &opts = CsrOptions());
+
+    int V() const;
+    std::size_t E() const;  // number of stored (directed) edges
+    std::size_t Degree(int v) const;
+    NeighborRange Neighbors(int v) const;
+
+    std::vector<int> PrimAlgorithm() const;
+    std::vector<int> BFS(int src) const;
+
+private:
+    int V_;
+    std::vector<std::size_t> start_;
+    std::vector<std::pair<int, int>> adj_;
+};
+
+#endif  /* CsrGraph_hpp */
@@ -0,0 +1,315 @@
+#ifndef ExternalPriorityQueue_hpp
+#define ExternalPriorityQueue_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Priority_Queue.hpp"
+
+//
+// A priority queue for more elements than fit in memory, after Sanders'
+// sequence heaps. New elements go to an in-memory insertion heap; when it
+// fills up it is drained, best first, into a sorted run in a temporary file.
+// Each run keeps one block in memory, and a small heap over the heads of
+// the runs merges them lazily as the queue is dequeued, the front being the
+// better of its front and the insertion heap's.
+//
+// Runs are grouped into levels, new ones going to level 0. When a level
+// holds R runs, R being as many blocks as fit in half the budget, those R
+// runs alone are merged into one run on the next level. An element is so
+// rewritten at most once per level, and there are O(log_R(n / m)) levels
+// for n elements and an insertion heap of m.
+//
+// memoryBytes bounds the memory used for elements, roughly: half for the
+// insertion heap, half for the run blocks of each level, so the queue
+// takes (1 + L) / 2 times the budget with L levels of runs. blockBytes is
+// the unit of file I/O; the files are unbuffered otherwise. Elements are
+// written to disk as raw bytes, so T must be trivially copyable. As with
+// Priority_Queue, the front is the element ranking highest under C:
+// std::greater<T> gives the min queue an event simulation wants.
+//
+template<typename T, typename C = std::less<T>>
+class ExternalPriorityQueue {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "elements are spilled to disk as raw bytes");
+public:
+    explicit ExternalPriorityQueue(size_t memoryBytes = 64 << 20, size_t blockBytes = 1 << 20,
+                                   const C &c = C());
+    ExternalPriorityQueue(const ExternalPriorityQueue&) = delete;
+    ExternalPriorityQueue& operator=(const ExternalPriorityQueue&) = delete;
+
+    //
+    // Time Complexity: O(lg m) for an insertion heap of m elements, plus an
+    // amortized O(lg R) per level for merging and O(1 / B) block writes per
+    // level for blocks of B elements, an element being written once to
+    // level 0 and once more to each level its run is merged into
+    //
+    void push(T elem);
+
+    //
+    // Removes and returns the front element; throws on an empty queue.
+    //
+    // Time Complexity: O(lg m + lg r) for r runs, plus a block read every
+    // blockBytes / sizeof(T) elements of a run
+    //
+    T pop();
+
+    // Users should check for emptiness beforehand.
+    const T& front() const;
+
+    bool empty() const;
+    size_t size() const;
+    size_t runs() const;     // runs currently on disk
+    size_t written() const;  // elements written to disk so far
+
+private:
+    struct FileCloser {
+        void operator()(std::FILE *f) const
+        {
+            std::fclose(f);
+        }
+    };
+
+    struct Run {
+        std::unique_ptr<std::FILE, FileCloser> file;
+        std::vector<T> block;  // the block being read, block[pos] the head
+        size_t pos {0};
+        size_t left {0};       // elements still on disk
+        size_t level {0};
+    };
+
+    struct Head {
+        T value;
+        size_t run;
+    };
+    struct HeadCompare {
+        C comp;
+        bool operator()(const Head &a, const Head &b) const
+        {
+            return comp(a.value, b.value);
+        }
+    };
+
+    using Heads = Priority_Queue<Head, HeadCompare>;
+
+    Priority_Queue<T, C> insert_;
+    std::vector<Run> runs_;
+    Heads heads_;
+    C comp_;
+    size_t size_ {0};
+    size_t heapCapacity_;  // elements
+    size_t blockSize_;     // elements
+    size_t maxRuns_;       // per level
+    size_t written_ {0};
+
+    bool front_in_heap() const;
+    void advance(size_t r, Heads &heads);
+    void spill();
+    bool merge(size_t level);
+    void drop_exhausted();
+    template<typename Next>
+    Run write_run(Next next);
+    void load(Run &run);
+};
+
+template<typename T, typename C>
+ExternalPriorityQueue<T, C>::ExternalPriorityQueue(size_t memoryBytes, size_t blockBytes,
+                                                   const C &c)
+: insert_(c), heads_(HeadCompare{c}), comp_(c)
+{
+    blockSize_ = std::max<size_t>(1, blockBytes / sizeof(T));
+    heapCapacity_ = std::max<size_t>(1, memoryBytes / 2 / sizeof(T));
+    maxRuns_ = std::max<size_t>(2, memoryBytes / 2 / (blockSize_ * sizeof(T)));
+}
+
+template<typename T, typename C>
+void ExternalPriorityQueue<T, C>::push(T elem)
+{
+    if (insert_.size() >= heapCapacity_)
+        spill();
+    insert_.push(elem);
+    ++size_;
+}
+
+template<typename T, typename C>
+T ExternalPriorityQueue<T, C>::pop()
+{
+    if (empty())
+        throw new std::out_of_range("Cannot dequeue an empty priority queue.");
+    --size_;
+    if (front_in_heap())
+        return insert_.pop();
+    Head head = heads_.pop();
+    advance(head.run, heads_);
+    return head.value;
+}
+
+template<typename T, typename C>
+const T& ExternalPriorityQueue<T, C>::front() const
+{
+    return front_in_heap() ? insert_.front() : heads_.front().value;
+}
+
+template<typename T, typename C>
+bool ExternalPriorityQueue<T, C>::empty() const
+{
+    return size_ == 0;
+}
+
+template<typename T, typename C>
+size_t ExternalPriorityQueue<T, C>::size() const
+{
+    return size_;
+}
+
+template<typename T, typename C>
+size_t ExternalPriorityQueue<T, C>::runs() const
+{
+    return heads_.size();
+}
+
+template<typename T, typename C>
+size_t ExternalPriorityQueue<T, C>::written() const
+{
+    return written_;
+}
+
+template<typename T, typename C>
+bool ExternalPriorityQueue<T, C>::front_in_heap() const
+{
+    return heads_.empty() || (!insert_.empty() && !comp_(insert_.front(), heads_.front().value));
+}
+
+//
+// Moves run r past its head, pushing the next head onto heads if there is
+// one.
+//
+template<typename T, typename C>
+void ExternalPriorityQueue<T, C>::advance(size_t r, Heads &heads)
+{
+    Run &run = runs_[r];
+    if (++run.pos == run.block.size())
+        load(run);
+    if (run.pos < run.block.size())
+        heads.push(Head{run.block[run.pos], r});
+    else
+        run.file.reset();  // exhausted
+}
+
+//
+// Empties the insertion heap into a new run on level 0, then merges every
+// level that has filled up into the next one.
+//
+template<typename T, typename C>
+void ExternalPriorityQueue<T, C>::spill()
+{
+    drop_exhausted();
+    runs_.push_back(write_run([this](T &out) {
+        if (insert_.empty())
+            return false;
+        out = insert_.pop();
+        return true;
+    }));
+    for (size_t level = 0; merge(level); level++)
+        ;
+
+    heads_ = Heads(HeadCompare{comp_});
+    for (size_t r = 0; r < runs_.size(); r++)
+        heads_.push(Head{runs_[r].block[runs_[r].pos], r});
+}
+
+//
+// Merges the runs on level into a single run on the next level if there
+// are R of them, returning whether it did. The rest of the queue is left
+// alone; heads_ is rebuilt by the caller.
+//
+template<typename T, typename C>
+bool ExternalPriorityQueue<T, C>::merge(size_t level)
+{
+    Heads heads (HeadCompare{comp_});
+    for (size_t r = 0; r < runs_.size(); r++)
+        if (runs_[r].level == level)
+            heads.push(Head{runs_[r].block[runs_[r].pos], r});
+    if (heads.size() < maxRuns_)
+        return false;
+
+    Run merged = write_run([this, &heads](T &out) {
+        if (heads.empty())
+            return false;
+        const Head head = heads.pop();
+        advance(head.run, heads);
+        out = head.value;
+        return true;
+    });
+    merged.level = level + 1;
+    drop_exhausted();
+    runs_.push_back(std::move(merged));
+    return true;
+}
+
+template<typename T, typename C>
+void ExternalPriorityQueue<T, C>::drop_exhausted()
+{
+    std::vector<Run> live;
+    for (Run &run : runs_)
+        if (run.file != nullptr)
+            live.push_back(std::move(run));
+    runs_ = std::move(live);
+}
+
+//
+// Writes the elements produced by next, which must come best first, to a
+// new temporary file one block at a time, and loads the first block back.
+//
+template<typename T, typename C>
+template<typename Next>
+typename ExternalPriorityQueue<T, C>::Run ExternalPriorityQueue<T, C>::write_run(Next next)
+{
+    Run run;
+    run.file.reset(std::tmpfile());
+    if (run.file == nullptr)
+        throw new std::runtime_error("Cannot create a temporary file to spill to.");
+    std::setvbuf(run.file.get(), nullptr, _IONBF, 0);
+
+    std::vector<T> &buffer = run.block;
+    buffer.reserve(blockSize_);
+    auto flush = [&] {
+        if (std::fwrite(buffer.data(), sizeof(T), buffer.size(), run.file.get()) != buffer.size())
+            throw new std::runtime_error("Cannot write a run to its temporary file.");
+        run.left += buffer.size();
+        written_ += buffer.size();
+        buffer.clear();
+    };
+    T elem;
+    while (next(elem)) {
+        buffer.push_back(elem);
+        if (buffer.size() == blockSize_)
+            flush();
+    }
+    flush();
+    std::rewind(run.file.get());
+    load(run);
+    return run;
+}
+
+//
+// Reads the next block of a run.
+//
+template<typename T, typename C>
+void ExternalPriorityQueue<T, C>::load(Run &run)
+{
+    const size_t n = std::min(blockSize_, run.left);
+    run.block.resize(n);
+    if (std::fread(run.block.data(), sizeof(T), n, run.file.get()) != n)
+        throw new std::runtime_error("Cannot read a run back from its temporary file.");
+    run.left -= n;
+    run.pos = 0;
+}
+
+#endif  /* ExternalPriorityQueue_hpp */
@@ -0,0 +1,206 @@
+#ifndef EytzingerArray_hpp
+#define EytzingerArray_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
+#include <utility>
+
+//
+// A static sorted sequence stored in Eytzinger (BFS) order: the root of the
+// implicit search tree at index 1 and the children of node i at 2i and 2i+1,
+// so the first levels every search visits share a few cache lines. Searches
+// are branchless, the next step choosing between 2i and 2i+1 by arithmetic.
+// Each step also prefetches the descendants of the node a few levels down,
+// which are contiguous in this layout and fill one cache line, so the memory
+// latency of those levels overlaps (Khuong and Morin, "Array layouts for
+// comparison-based searching").
+//
+// Built once in O(n) from keys in sorted order, duplicates allowed, such as
+// RbTree::Freeze() produces. The keys are copy-constructed into raw storage,
+// so T need not be default-constructible.
+//
+template<typename T, typename Compare = std::less<T>>
+class EytzingerArray {
+public:
+    using value_type = T;
+
+    explicit EytzingerArray(const Compare &comp = Compare()) : a(nullptr), n(0), comp(comp) {}
+    EytzingerArray(const EytzingerArray&) = delete;
+    EytzingerArray& operator=(const EytzingerArray&) = delete;
+
+    EytzingerArray(EytzingerArray &&e) : a(e.a), n(e.n), comp(std::move(e.comp))
+    {
+        e.a = nullptr;
+        e.n = 0;
+    }
+
+    EytzingerArray& operator=(EytzingerArray &&e)
+    {
+        if (this != &e) {
+            Release();
+            a = e.a, n = e.n, comp = std::move(e.comp);
+            e.a = nullptr;
+            e.n = 0;
+        }
+        return *this;
+    }
+
+    ~EytzingerArray()
+    {
+        Release();
+    }
+
+    //
+    // Lays out the keys in [first, last), which must be sorted under comp.
+    //
+    template<typename ForwardIterator>
+    EytzingerArray(ForwardIterator first, ForwardIterator last, const Compare &comp = Compare())
+    : EytzingerArray(static_cast<std::size_t>(std::distance(first, last)),
+                     [&first] { return *first++; }, comp) {}
+
+    //
+    // Lays out n keys produced in sorted order by calls to next().
+    //
+    // Time Complexity: O(n)
+    //
+    template<typename Next>
+    EytzingerArray(std::size_t n, Next next, const Compare &comp = Compare());
+
+    //
+    // The first key not ordered before key, or nullptr if there is none.
+    //
+    // Time Complexity: O(lg n), without branches on the keys
+    //
+    const T* LowerBound(const T &key) const
+    {
+        return Descend([&](const T &x) { return comp(x, key); });
+    }
+
+    //
+    // The first key ordered after key, or nullptr if there is none.
+    //
+    const T* UpperBound(const T &key) const
+    {
+        return Descend([&](const T &x) { return !comp(key, x); });
+    }
+
+    bool Contains(const T &key) const
+    {
+        const T *x = LowerBound(key);
+        return x != nullptr && !comp(key, *x);
+    }
+
+    std::size_t Size() const
+    {
+        return n;
+    }
+
+    // The keys in layout order, the root first; nullptr when empty.
+    const T* data() const
+    {
+        return n == 0 ? nullptr : a + 1;
+    }
+
+private:
+    static constexpr std::size_t LINE = 64;
+    static constexpr std::size_t ALIGN = alignof(T) > LINE ? alignof(T) : LINE;
+    // The nodes i levels below node k start at k << i; four levels down
+    // fill a line for 4-byte keys, three for 8-byte ones.
+    static constexpr std::size_t PREFETCH_STRIDE = LINE / sizeof(T) > 0 ? LINE / sizeof(T) : 1;
+
+    T *a;  // 1-based, &a[0] aligned to a cache line and never constructed
+    std::size_t n;
+    Compare comp;
+
+    template<typename Next>
+    void Fill(std::size_t k, Next &next, std::size_t &built);
+    void Destroy(std::size_t k, std::size_t &left);
+    void Release();
+
+    //
+    // Walks down while right(x) says that x is ordered before the bound,
+    // then undoes the trailing right turns and the last left one: the node
+    // left that way is the bound.
+    //
+    template<typename Right>
+    const T* Descend(Right right) const
+    {
+        std::size_t i = 1;
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(a);
+        while (i <= n) {
+            // the descendants may lie past the end: no pointer arithmetic
+            __builtin_prefetch(reinterpret_cast<const void*>(base + i * PREFETCH_STRIDE * sizeof(T)));
+            i = 2 * i + right(a[i]);
+        }
+        i >>= __builtin_ffsll(~static_cast<long long>(i));
+        return i == 0 ? nullptr : a + i;
+    }
+};
+
+template<typename T, typename Compare>
+template<typename Next>
+EytzingerArray<T, Compare>::EytzingerArray(std::size_t n, Next next, const Compare &comp)
+: a(nullptr), n(n), comp(comp)
+{
+    if (n == 0)
+        return;
+    a = static_cast<T*>(::operator new((n + 1) * sizeof(T), std::align_val_t(ALIGN)));
+    std::size_t built = 0;
+    try {
+        Fill(1, next, built);
+    } catch (...) {
+        Destroy(1, built);
+        ::operator delete(a, std::align_val_t(ALIGN));
+        throw;
+    }
+}
+
+//
+// Fills the subtree rooted at k in order, that is in sorted order, counting
+// the keys constructed so far in built.
+//
+template<typename T, typename Compare>
+template<typename Next>
+void EytzingerArray<T, Compare>::Fill(std::size_t k, Next &next, std::size_t &built)
+{
+    if (k > n)
+        return;
+    Fill(2 * k, next, built);
+    ::new (static_cast<void*>(a + k)) T(next());
+    built++;
+    Fill(2 * k + 1, next, built);
+}
+
+//
+// Destroys the first left keys of the subtree rooted at k, in the order
+// Fill constructed them.
+//
+template<typename T, typename Compare>
+void EytzingerArray<T, Compare>::Destroy(std::size_t k, std::size_t &left)
+{
+    if (k > n || left == 0)
+        return;
+    Destroy(2 * k, left);
+    if (left == 0)
+        return;
+    a[k].~T();
+    left--;
+    Destroy(2 * k + 1, left);
+}
+
+template<typename T, typename Compare>
+void EytzingerArray<T, Compare>::Release()
+{
+    if (a == nullptr)
+        return;
+    for (std::size_t k = 1; k <= n; k++)
+        a[k].~T();
+    ::operator delete(a, std::align_val_t(ALIGN));
+    a = nullptr;
+    n = 0;
+}
+
+#endif  /* EytzingerArray_hpp */
@@ -1,120 +1,497 @@
 #ifndef FibHeap_hpp
 #define FibHeap_hpp
 
-#include "List.hpp"
-
-//
-// A Node of a Fibonacci Heap. Contains a key attribute that determines its
-// position within the tree, a degree attribute that stores the number of
-// children the node has, a marked attribute useful for CUT and CASCADING-CUT
-// procedures used in DECREASE-KEY, a circular doubly-linked list of its
-// children, as well as its corresponding linked list node by which the tree
-// is connected.
-//
-struct FibNode {
-    int key;
-    int degree {0};
-    bool marked {false};
-    FibNode *parent {nullptr};
-    List<FibNode*> children;
-    ListNode<FibNode*> *lnode;
-    
-    FibNode(int _key = 0) : key{_key}, lnode{new ListNode<FibNode*>(this)} {}
-};
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
 
 //
 // A Fibonacci Heap is a data structure that supports the mergeable heap
 // operations, as well as the operations DECREASE-KEY and DELETE. Many of
 // the operations supported by a F. heap run in constant amortized time, making
 // them well-suited for applications that frequently invoke them. Fibonacci
-// heaps have better asymptotic time bounds than binary heaps in their INSERT, 
+// heaps have better asymptotic time bounds than binary heaps in their INSERT,
 // DECREASE-KEY and UNION operations, each of which run in amortized O(1).
 //
 // Fibonacci Heaps have different use cases from binary heaps. They are mostly
 // used in an amortized setting, where the total cost is much more important
-// than per-operation worst-case costs. Examples include Prim's Algorithm for 
+// than per-operation worst-case costs. Examples include Prim's Algorithm for
 // finding minimum spanning trees and Djikstra's algorithm for single-source
 // shortest paths.
 //
+// Every entry pairs a Key with a Value; the entry whose key comes first
+// under Compare (the smallest, with std::less) is the minimum. Insert returns
+// a Handle to the entry, valid until the entry leaves the heap, by which
+// DECREASE-KEY and DELETE name it. Nodes come from a NodePool that recycles
+// the nodes of extracted entries, so a heap in steady use does not allocate.
+//
+template<typename Key, typename Value, typename Compare = std::less<Key>>
 class FibHeap {
-public:
     //
-    // Inserts a node into the fibonacci heap by simply appending to the
-    // root list. Consecutive insertions will result in a fibonacci heap
-    // resembling a linear chain of nodes.
+    // A Node of a Fibonacci Heap. Contains the key that determines its
+    // position within the tree, a degree attribute that stores the number of
+    // children the node has, a marked attribute useful for CUT and
+    // CASCADING-CUT procedures used in DECREASE-KEY, and the links that tie
+    // it into the heap: its parent, any one of its children, and its left and
+    // right siblings in a circular doubly-linked list. The links live inside
+    // the node itself, so siblings are one hop apart.
     //
-    // Time Complexity: Amortized O(1)
+    struct Node {
+        Key key;
+        Value value;
+        int degree {0};
+        bool marked {false};
+        Node *parent {nullptr};
+        Node *child {nullptr};
+        Node *left {this};
+        Node *right {this};
+
+        Node(Key &&_key, Value &&_value) : key{std::move(_key)}, value{std::move(_value)} {}
+    };
+
+public:
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool operator==(const Handle &h) const
+        {
+            return node_ == h.node_;
+        }
+        bool operator!=(const Handle &h) const
+        {
+            return node_ != h.node_;
+        }
+
+    private:
+        friend class FibHeap;
+        explicit Handle(Node *node) : node_{node} {}
+        Node *node_ {nullptr};
+    };
+
+    //
+    // A view of the keys of the roots, from the head of the root list
+    // rightwards. Inserting or removing entries invalidates it.
     //
-    void Insert(FibNode* fnode);
+    class SiblingRange {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Key;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Key*;
+            using reference = const Key&;
+
+            iterator(const Node *node, const Node *head) : cur{node}, head{head} {}
+
+            iterator& operator++()
+            {
+                cur = cur->right == head ? nullptr : cur->right;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator copy(*this);
+                ++*this;
+                return copy;
+            }
+            bool operator==(const iterator &it) const
+            {
+                return cur == it.cur;
+            }
+            bool operator!=(const iterator &it) const
+            {
+                return cur != it.cur;
+            }
+            const Key& operator*() const
+            {
+                return cur->key;
+            }
+
+        private:
+            const Node *cur;  // nullptr once past the last sibling
+            const Node *head;
+        };
+
+        explicit SiblingRange(const Node *head) : head_{head} {}
+
+        iterator begin() const
+        {
+            return iterator(head_, head_);
+        }
+        iterator end() const
+        {
+            return iterator(nullptr, head_);
+        }
+        bool empty() const
+        {
+            return head_ == nullptr;
+        }
+
+    private:
+        const Node *head_;
+    };
+
+    explicit FibHeap(const Compare &comp = Compare()) : comp_{comp} {}
+    FibHeap(const FibHeap&) = delete;
+    FibHeap& operator=(const FibHeap&) = delete;
 
     //
-    // Inserts a node with the given value into the fibonacci heap. Provides
-    // an additional layer of abstraction over the standard INSERT.
+    // Inserts an entry into the fibonacci heap by simply prepending its node
+    // to the root list. Consecutive insertions will result in a fibonacci
+    // heap resembling a linear chain of nodes.
     //
     // Time Complexity: Amortized O(1)
     //
-    void InsertVal(int x);
+    Handle Insert(Key key, Value value);
 
     //
-    // Merges two fibonacci heaps by simply joining their root lists. The
-    // unioned node is destroyed in the process.
+    // Merges two fibonacci heaps by simply splicing their root lists
+    // together; the handles into h remain valid. The unioned heap is left
+    // empty.
     //
-    // Time Complexity: Amortized O(1)
+    // Time Complexity: Amortized O(1), plus O(free nodes of h) to adopt them
     //
     void Union(FibHeap&& h);
 
     //
-    // Extracts the node with the minimum key from the fibonacci heap. The
-    // extracted minimum node retains all of its properties. The deallocation
-    // of the returned node should be properly handled by the user.
+    // Extracts the entry with the minimum key and returns its key and value.
+    // The heap must not be empty.
     //
     // Time Complexity: Amortized O(lg n)
     //
-    FibNode* ExtractMin();
+    std::pair<Key, Value> ExtractMin();
 
     //
-    // Extracts the node with the minimum key and returns its key. Provides
-    // an additional layer of abstraction over the standard EXTRACT-MIN.
+    // Decreases the key of an entry; keys that do not come before the
+    // current one are ignored.
     //
-    // Time Complexity: Amortized O(lg n)
+    // Time Complexity: Amortized O(1)
     //
-    int ExtractMinVal();
+    void DecreaseKey(Handle h, Key decreasedKey);
 
     //
-    // Decreases the key of a particular node.
+    // Removes an entry from the heap, whatever its key.
     //
-    // Time Complexity: Amortized O(1)
+    // Time Complexity: Amortized O(lg n)
     //
-    void DecreaseKey(FibNode *fnode, int decreasedKey);
+    void Delete(Handle h);
 
     //
-    // Recursively deallocates all the nodes of the fibonacci heap.
+    // Destroys all the entries of the fibonacci heap, splicing the children
+    // of every node into the list still to be visited rather than recursing.
+    // With trivially destructible keys and values, the node pool is simply
+    // released.
     //
     ~FibHeap();
 
     // Accessors
 
-    List<FibNode*>& rootList();
+    SiblingRange rootList() const;
 
     int size() const;
     bool empty() const;
 
-    const FibNode* min() const;
-    int minVal() const;
+    // Users should check for emptiness beforehand.
+    const Key& minKey() const;
+    const Value& minValue() const;
+
+    const Key& key(Handle h) const;
+    Value& value(Handle h);
+    const Value& value(Handle h) const;
 
 private:
     int size_ {0};  // contains the total count of nodes in the heap
 
-    FibNode *min_ {nullptr};  // contains the node with minimum key
+    Node *min_ {nullptr};  // contains the node with minimum key
+
+    Node *roots_ {nullptr};  // head of the circular list of roots
 
-    List<FibNode*> rootList_;  // chains the roots of subtrees in a linked list
+    Compare comp_;
 
-    void FreeNodes(FibNode *root);
+    NodePool<Node> pool_;
+
+    // Consolidate() buckets the roots by degree here. Kept between calls, so
+    // EXTRACT-MIN does not allocate; entries are all nullptr between calls.
+    std::vector<Node*> degreeTable_;
+
+    static void Splice(Node *fnode, Node *&head);
+    static void Unlink(Node *fnode, Node *&head);
+
+    Node* ExtractMinNode();
     void Consolidate();
-    void Link(FibNode *child, FibNode *parent);
-    void Cut(FibNode *child, FibNode *parent);
-    void CascadingCut(FibNode *fnode);
+    void Link(Node *child, Node *parent);
+    void Cut(Node *child, Node *parent);
+    void CascadingCut(Node *fnode);
 };
 
-#endif  /* FibHeap_hpp */
+template<typename Key, typename Value, typename Compare>
+typename FibHeap<Key, Value, Compare>::Handle
+FibHeap<Key, Value, Compare>::Insert(Key key, Value value)
+{
+    Node *fnode = pool_.New(std::move(key), std::move(value));
+    Splice(fnode, roots_);
+    if (min_ == nullptr || comp_(fnode->key, min_->key))
+        min_ = fnode;
+    ++size_;
+    return Handle(fnode);
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Union(FibHeap&& h)
+{
+    pool_.Merge(std::move(h.pool_));
+    if (h.roots_ == nullptr)
+        return;
+    if (roots_ == nullptr) {
+        roots_ = h.roots_;
+        min_ = h.min_;
+    } else {
+        // close both circles into one: our roots followed by those of h
+        Node *tail = roots_->left, *htail = h.roots_->left;
+        tail->right = h.roots_, h.roots_->left = tail;
+        htail->right = roots_, roots_->left = htail;
+        min_ = comp_(h.min_->key, min_->key) ? h.min_ : min_;
+    }
+    size_ += h.size_;
+
+    h.size_ = 0;
+    h.roots_ = nullptr;
+    h.min_ = nullptr;
+}
+
+template<typename Key, typename Value, typename Compare>
+std::pair<Key, Value> FibHeap<Key, Value, Compare>::ExtractMin()
+{
+    Node *z = ExtractMinNode();
+    std::pair<Key, Value> entry (std::move(z->key), std::move(z->value));
+    pool_.Delete(z);
+    return entry;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::DecreaseKey(Handle h, Key decreasedKey)
+{
+    Node *fnode = h.node_;
+    if (!comp_(decreasedKey, fnode->key))
+        return;
+    fnode->key = std::move(decreasedKey);
+    Node* parent = fnode->parent;
+    if (parent != nullptr && comp_(fnode->key, parent->key)) {
+        Cut(fnode, parent);
+        CascadingCut(parent);
+    }
+    if (comp_(fnode->key, min_->key))
+        min_ = fnode;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Delete(Handle h)
+{
+    // As if decreased to minus infinity: cut to the root list, made the
+    // minimum, and extracted.
+    Node *fnode = h.node_;
+    Node *parent = fnode->parent;
+    if (parent != nullptr) {
+        Cut(fnode, parent);
+        CascadingCut(parent);
+    }
+    min_ = fnode;
+    pool_.Delete(ExtractMinNode());
+}
+
+template<typename Key, typename Value, typename Compare>
+FibHeap<Key, Value, Compare>::~FibHeap()
+{
+    if (std::is_trivially_destructible<Node>::value || roots_ == nullptr)
+        return;  // pool_ releases the memory
+    // Walk the roots as a chain ending in nullptr; the children of every
+    // node are spliced in right behind it before it is destroyed.
+    roots_->left->right = nullptr;
+    for (Node *x = roots_, *next; x != nullptr; x = next) {
+        if (Node *c = x->child) {
+            c->left->right = x->right;
+            x->right = c;
+        }
+        next = x->right;
+        pool_.Delete(x);
+    }
+}
+
+template<typename Key, typename Value, typename Compare>
+typename FibHeap<Key, Value, Compare>::SiblingRange
+FibHeap<Key, Value, Compare>::rootList() const
+{
+    return SiblingRange(roots_);
+}
+
+template<typename Key, typename Value, typename Compare>
+int FibHeap<Key, Value, Compare>::size() const
+{
+    return size_;
+}
+
+template<typename Key, typename Value, typename Compare>
+bool FibHeap<Key, Value, Compare>::empty() const
+{
+    return size_ == 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Key& FibHeap<Key, Value, Compare>::minKey() const
+{
+    return min_->key;
+}
 
+template<typename Key, typename Value, typename Compare>
+const Value& FibHeap<Key, Value, Compare>::minValue() const
+{
+    return min_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Key& FibHeap<Key, Value, Compare>::key(Handle h) const
+{
+    return h.node_->key;
+}
+
+template<typename Key, typename Value, typename Compare>
+Value& FibHeap<Key, Value, Compare>::value(Handle h)
+{
+    return h.node_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Value& FibHeap<Key, Value, Compare>::value(Handle h) const
+{
+    return h.node_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Splice(Node *fnode, Node *&head)
+{
+    if (head == nullptr) {
+        fnode->left = fnode->right = fnode;
+    } else {
+        fnode->right = head, fnode->left = head->left;
+        head->left->right = fnode, head->left = fnode;
+    }
+    head = fnode;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Unlink(Node *fnode, Node *&head)
+{
+    if (fnode->right == fnode) {
+        head = nullptr;
+    } else {
+        fnode->left->right = fnode->right, fnode->right->left = fnode->left;
+        if (head == fnode)
+            head = fnode->right;
+    }
+    fnode->left = fnode->right = fnode;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename FibHeap<Key, Value, Compare>::Node* FibHeap<Key, Value, Compare>::ExtractMinNode()
+{
+    Node *z = min_;
+    if (Node *c = z->child) {
+        // promote the children by splicing their whole list in after z
+        Node *x = c;
+        do {
+            x->parent = nullptr;
+            x = x->right;
+        } while (x != c);
+        Node *last = c->left;
+        last->right = z->right, z->right->left = last;
+        z->right = c, c->left = z;
+        z->child = nullptr;
+    }
+    Unlink(z, roots_);
+    --size_;
+    if (roots_ == nullptr)
+        min_ = nullptr;
+    else
+        Consolidate();
+    return z;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Consolidate()
+{
+    // Degrees never exceed log_phi(n) < 1.45 lg n, so the table rarely grows.
+    const std::size_t LG_SIZE = 32 - __builtin_clz(size_);
+    const std::size_t MAX_DEGREE = LG_SIZE * 3 / 2 + 2;
+    if (degreeTable_.size() < MAX_DEGREE)
+        degreeTable_.resize(MAX_DEGREE, nullptr);
+
+    // The roots are walked as a chain ending in nullptr; their links are
+    // rewritten freely as the root list is rebuilt from the table below.
+    int maxDegree = 0;
+    roots_->left->right = nullptr;
+    for (Node *w = roots_, *next; w != nullptr; w = next) {
+        next = w->right;
+        Node *x = w;
+        int d = x->degree;
+        for (; degreeTable_[d] != nullptr; d++) {
+            Node *y = degreeTable_[d];
+            if (comp_(y->key, x->key))
+                std::swap(x, y);
+            Link(y, x);
+            degreeTable_[d] = nullptr;
+        }
+        degreeTable_[d] = x;
+        maxDegree = std::max(maxDegree, d);
+    }
+    roots_ = min_ = nullptr;
+    for (int d = 0; d <= maxDegree; d++) {
+        Node *x = degreeTable_[d];
+        if (x == nullptr) continue;
+        degreeTable_[d] = nullptr;
+        Splice(x, roots_);
+        if (min_ == nullptr || comp_(x->key, min_->key))
+            min_ = x;
+    }
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Link(Node *child, Node *parent)
+{
+    // child has already left the root list, see Consolidate()
+    Splice(child, parent->child);
+    child->parent = parent;
+    child->marked = false;
+    ++parent->degree;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::Cut(Node *child, Node *parent)
+{
+    Unlink(child, parent->child);
+    --parent->degree;
+    Splice(child, roots_);
+    child->parent = nullptr;
+    child->marked = false;
+}
+
+template<typename Key, typename Value, typename Compare>
+void FibHeap<Key, Value, Compare>::CascadingCut(Node *fnode)
+{
+    for (Node *parent = fnode->parent; parent != nullptr; parent = fnode->parent) {
+        if (!fnode->marked) {
+            fnode->marked = true;
+            return;
+        }
+        Cut(fnode, parent);
+        fnode = parent;
+    }
+}
+
+#endif  /* FibHeap_hpp */
@@ -1,22 +1,90 @@
 #ifndef Graph_hpp
 #define Graph_hpp
 
+#include <cstddef>
 #include <vector>
 #include <utility>
 
 class Graph {
 public:
-    explicit Graph(int V);
+    //
+    // Creates a graph on vertices [0, V). Edges of an undirected graph are
+    // stored in both directions; those of a directed one only from src.
+    //
+    explicit Graph(int V, bool directed = false);
     void AddEdge(int src, int dest, int weight = 0);
 
+    int V() const;
+    bool Directed() const;
+
+    //
+    // Returns the (destination, weight) pairs of the edges leaving v in
+    // insertion order.
+    //
+    const std::vector<std::pair<int, int>>& Neighbors(int v) const;
+
     std::vector<int> PrimAlgorithm();
+    std::vector<int> BFS(int src) const;
 
-private:
-    static constexpr int MAX_V {1000};
+    //
+    // Returns the vertices adjacent to both u and v in ascending order.
+    // Parallel edges and self-loops are ignored, as are edge directions.
+    //
+    // Time Complexity: O(deg(u) + deg(v)), or O(d lg D) for degrees d << D
+    //
+    std::vector<int> CommonNeighbors(int u, int v);
+
+    //
+    // Counts the triangles of the graph. Every edge is oriented from the
+    // endpoint of lower degree to the one of higher degree (ties broken by
+    // id), so each triangle is found exactly once and no vertex has more
+    // than O(sqrt(E)) out-neighbors; the out-neighbor lists of the two ends
+    // of every oriented edge are then intersected. Vertices are distributed
+    // among `numThreads` threads (all hardware threads by default).
+    //
+    // Time Complexity: O(E sqrt(E))
+    //
+    long long CountTriangles(int numThreads = 0);
+
+    //
+    // Computes the distances between all pairs of vertices as a row-major
+    // V x V matrix (INF_DIST for unreachable pairs, see ShortestPaths.hpp),
+    // or returns an empty vector if the graph has a negative cycle. Sparse
+    // graphs run Johnson's algorithm, dense ones the blocked Floyd-Warshall.
+    //
+    // Time Complexity: O(min(V^3, VE lg E))
+    //
+    std::vector<int> AllPairsShortestPaths(int numThreads = 0) const;
+
+    //
+    // Returns the strongly connected component of every vertex (connected
+    // component for undirected graphs), numbered from 0, using the iterative
+    // Tarjan's algorithm; ids follow a reverse topological order.
+    //
+    // Time Complexity: O(V + E)
+    //
+    std::vector<int> StronglyConnectedComponents() const;
 
+    //
+    // Same components as above, found with the parallel forward-backward
+    // algorithm; the numbering follows no particular order. Pays off on
+    // large graphs with many threads.
+    //
+    std::vector<int> ParallelStronglyConnectedComponents(int numThreads = 0) const;
+
+private:
     int V_;
-    std::vector<std::pair<int, int>> ls_[MAX_V];
+    bool directed_;
+    std::vector<std::vector<std::pair<int, int>>> ls_;
+
+    // Sorted, duplicate-free ids of the vertices adjacent to v in either
+    // direction, in compressed sparse row form: they are nbrs_[nbrStart_[v]
+    // .. nbrStart_[v + 1]). Built lazily and invalidated by AddEdge.
+    std::vector<std::size_t> nbrStart_;
+    std::vector<int> nbrs_;
+    bool sorted_ {false};
+
+    void SortNeighbors();
 };
 
 #endif  /* Graph_hpp */
-
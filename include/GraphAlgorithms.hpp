@@ -0,0 +1,89 @@
+#ifndef GraphAlgorithms_hpp
+#define GraphAlgorithms_hpp
+
+#include <vector>
+#include <functional>
+#include <utility>
+#include "IndexedPriorityQueue.hpp"
+
+//
+// Graph algorithms shared by every adjacency representation in the library.
+// A graph type G only needs to provide
+//
+//     int V() const;
+//     <range of std::pair<int, int>> Neighbors(int v) const;
+//
+// where each pair holds the destination and the weight of an edge. Both the
+// plain Graph and the delta-encoded CompressedGraph qualify, so the
+// algorithms run unchanged on either.
+//
+
+//
+// Prim's algorithm for minimum spanning trees. Returns the parent of every
+// vertex in the tree grown from vertex 0; the root is its own parent and
+// vertices unreachable from it have parent -1. The queue holds every vertex
+// at most once, its key being lowered in place when a lighter edge shows up.
+//
+// Time Complexity: O(E lg V)
+//
+template<typename G>
+std::vector<int> PrimMST(const G &g)
+{
+    const int INF = 1000000007;
+    const int ROOT = 0;  // picking arbitarily suffices
+    const int V = g.V();
+
+    std::vector<int> key (V, INF);
+    std::vector<int> parent (V, -1);
+    std::vector<bool> in_tree (V, false);
+    IndexedPriorityQueue<int, std::greater<int>> q (V);
+
+    key[ROOT] = 0, parent[ROOT] = ROOT;
+    q.push(ROOT, 0);
+
+    while (!q.empty()) {
+        int src = q.pop();
+        in_tree[src] = true;
+        for (std::pair<int, int> edge : g.Neighbors(src)) {
+            int dest = edge.first, w = edge.second;
+            if (!in_tree[dest] && w < key[dest]) {
+                key[dest] = w, parent[dest] = src;
+                if (q.contains(dest))
+                    q.decrease_key(dest, w);
+                else
+                    q.push(dest, w);
+            }
+        }
+    }
+    return parent;
+}
+
+//
+// Breadth-first search from `src`, expanding one frontier at a time. Returns
+// the number of edges on a shortest path to every vertex, or -1 for vertices
+// that cannot be reached.
+//
+// Time Complexity: O(V + E)
+//
+template<typename G>
+std::vector<int> BreadthFirstSearch(const G &g, int src)
+{
+    std::vector<int> dist (g.V(), -1);
+    std::vector<int> frontier {src}, next;
+    dist[src] = 0;
+    for (int level = 1; !frontier.empty(); level++) {
+        next.clear();
+        for (int v : frontier) {
+            for (std::pair<int, int> edge : g.Neighbors(v)) {
+                if (dist[edge.first] == -1) {
+                    dist[edge.first] = level;
+                    next.push_back(edge.first);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return dist;
+}
+
+#endif  /* GraphAlgorithms_hpp */
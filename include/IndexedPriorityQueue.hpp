@@ -0,0 +1,231 @@
+#ifndef IndexedPriorityQueue_hpp
+#define IndexedPriorityQueue_hpp
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+//
+// A binary heap over the dense ids [0, n), each present at most once with a
+// key of type K. A position array maps every id to its slot in the heap, so
+// the key of any entry can be changed, or the entry erased, in O(lg n)
+// without leaving stale duplicates behind: the heap never holds more than
+// n entries, however many updates are made.
+//
+// As with Priority_Queue, C ranks the keys and the front is the entry whose
+// key ranks highest: std::less<K> yields a max queue, std::greater<K> the min
+// queue that Prim's and Dijkstra's algorithms want.
+//
+template<typename K, typename C = std::less<K>>
+class IndexedPriorityQueue {
+public:
+    explicit IndexedPriorityQueue(int n, const C &c = C());
+
+    //
+    // Inserts id, which must not be present, with the given key.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void push(int id, K key);
+
+    //
+    // Gives id, which must be present, a key ranking at least as high as
+    // its current one (a smaller key for a min queue) and moves it up.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void decrease_key(int id, K key);
+
+    //
+    // Gives id, which must be present, any new key.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void change_key(int id, K key);
+
+    //
+    // Removes id from the queue if it is present.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void erase(int id);
+
+    //
+    // Removes the front entry and returns its id. The queue must not be
+    // empty.
+    //
+    // Time Complexity: O(lg n)
+    //
+    int pop();
+
+    bool contains(int id) const;
+    const K& key(int id) const;  // id must be present
+
+    int top() const;  // id of the front entry
+    const K& top_key() const;
+
+    bool empty() const;
+    size_t size() const;
+    int capacity() const;  // ids range over [0, capacity())
+
+private:
+    struct Entry {
+        K key;
+        int id;
+    };
+
+    std::vector<Entry> heap_;
+    std::vector<int> pos_;  // slot of every id in heap_, -1 when absent
+    C comp_;
+
+    static int parent(int idx)
+    {
+        return (idx - 1) / 2;
+    }
+    static int left(int idx)
+    {
+        return 2 * idx + 1;
+    }
+
+    void place(int idx, Entry &&entry);
+    void sift_up(int idx, Entry &&entry);
+    void sift_down(int idx, Entry &&entry);
+};
+
+template<typename K, typename C>
+IndexedPriorityQueue<K, C>::IndexedPriorityQueue(int n, const C &c)
+: pos_(n, -1), comp_(c)
+{
+}
+
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::push(int id, K key)
+{
+    heap_.push_back(Entry{std::move(key), id});
+    Entry entry = std::move(heap_.back());
+    sift_up(heap_.size() - 1, std::move(entry));
+}
+
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::decrease_key(int id, K key)
+{
+    const int idx = pos_[id];
+    sift_up(idx, Entry{std::move(key), id});
+}
+
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::change_key(int id, K key)
+{
+    const int idx = pos_[id];
+    if (comp_(heap_[idx].key, key))
+        sift_up(idx, Entry{std::move(key), id});
+    else
+        sift_down(idx, Entry{std::move(key), id});
+}
+
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::erase(int id)
+{
+    const int idx = pos_[id];
+    if (idx == -1)
+        return;
+    pos_[id] = -1;
+    Entry last = std::move(heap_.back());
+    heap_.pop_back();
+    if (idx == static_cast<int>(heap_.size()))
+        return;  // id was the last entry
+    // the last entry fills the slot of id, moving whichever way it must
+    if (idx > 0 && comp_(heap_[parent(idx)].key, last.key))
+        sift_up(idx, std::move(last));
+    else
+        sift_down(idx, std::move(last));
+}
+
+template<typename K, typename C>
+int IndexedPriorityQueue<K, C>::pop()
+{
+    const int id = heap_.front().id;
+    erase(id);
+    return id;
+}
+
+template<typename K, typename C>
+bool IndexedPriorityQueue<K, C>::contains(int id) const
+{
+    return pos_[id] != -1;
+}
+
+template<typename K, typename C>
+const K& IndexedPriorityQueue<K, C>::key(int id) const
+{
+    return heap_[pos_[id]].key;
+}
+
+template<typename K, typename C>
+int IndexedPriorityQueue<K, C>::top() const
+{
+    return heap_.front().id;
+}
+
+template<typename K, typename C>
+const K& IndexedPriorityQueue<K, C>::top_key() const
+{
+    return heap_.front().key;
+}
+
+template<typename K, typename C>
+bool IndexedPriorityQueue<K, C>::empty() const
+{
+    return heap_.empty();
+}
+
+template<typename K, typename C>
+size_t IndexedPriorityQueue<K, C>::size() const
+{
+    return heap_.size();
+}
+
+template<typename K, typename C>
+int IndexedPriorityQueue<K, C>::capacity() const
+{
+    return pos_.size();
+}
+
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::place(int idx, Entry &&entry)
+{
+    pos_[entry.id] = idx;
+    heap_[idx] = std::move(entry);
+}
+
+//
+// Like Priority_Queue, both sifts move a hole rather than swapping entries,
+// keeping pos_ up to date for every entry they move.
+//
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::sift_up(int idx, Entry &&entry)
+{
+    while (idx > 0 && comp_(heap_[parent(idx)].key, entry.key)) {
+        place(idx, std::move(heap_[parent(idx)]));
+        idx = parent(idx);
+    }
+    place(idx, std::move(entry));
+}
+
+template<typename K, typename C>
+void IndexedPriorityQueue<K, C>::sift_down(int idx, Entry &&entry)
+{
+    const int sz = heap_.size();
+    for (int c = left(idx); c < sz; c = left(idx)) {
+        if (c + 1 < sz && comp_(heap_[c].key, heap_[c + 1].key))
+            ++c;
+        if (!comp_(entry.key, heap_[c].key))
+            break;
+        place(idx, std::move(heap_[c]));
+        idx = c;
+    }
+    place(idx, std::move(entry));
+}
+
+#endif  /* IndexedPriorityQueue_hpp */
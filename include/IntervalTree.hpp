@@ -0,0 +1,138 @@
+#ifndef IntervalTree_hpp
+#define IntervalTree_hpp
+
+#include <utility>
+#include <vector>
+#include "RbTree.hpp"
+
+//
+// A closed interval [low, high] over any type ordered by operator<.
+//
+template<typename T>
+struct Interval {
+    T low;
+    T high;
+
+    bool operator==(const Interval &i) const
+    {
+        return !(low < i.low) && !(i.low < low) && !(high < i.high) && !(i.high < high);
+    }
+    bool operator!=(const Interval &i) const
+    {
+        return !(*this == i);
+    }
+};
+
+//
+// Orders intervals by their low endpoint, then by their high one.
+//
+template<typename T>
+struct IntervalLess {
+    bool operator()(const Interval<T> &a, const Interval<T> &b) const
+    {
+        return a.low < b.low || (!(b.low < a.low) && a.high < b.high);
+    }
+};
+
+//
+// Augments every node with the largest high endpoint in its subtree
+// (CLRS 14.3).
+//
+template<typename T>
+struct RbMaxEndpoint {
+    using Data = T;
+
+    template<typename Node>
+    static void Update(Node *x)
+    {
+        x->aug = x->key.high;
+        if (x->left != Node::NIL && x->aug < x->left->aug)
+            x->aug = x->left->aug;
+        if (x->right != Node::NIL && x->aug < x->right->aug)
+            x->aug = x->right->aug;
+    }
+};
+
+//
+// An RbTree of intervals keyed by their low endpoint, whose nodes know the
+// largest high endpoint below them. A query for the intervals overlapping
+// [low, high] walks the tree in order, skipping every subtree whose largest
+// endpoint falls short of low and stopping at the first interval starting
+// after high.
+//
+template<typename T, bool Pooled = false>
+class IntervalTree : public RbTree<Interval<T>, IntervalLess<T>, Pooled, RbMaxEndpoint<T>> {
+    using Base = RbTree<Interval<T>, IntervalLess<T>, Pooled, RbMaxEndpoint<T>>;
+public:
+    using Node = typename Base::Node;
+    using Base::Insert;
+    using Base::Erase;
+
+    Node* Insert(T low, T high)
+    {
+        return Base::Insert(Interval<T>{std::move(low), std::move(high)});
+    }
+
+    bool Erase(const T &low, const T &high)
+    {
+        return Base::Erase(Interval<T>{low, high});
+    }
+
+    //
+    // Some node whose interval overlaps [low, high], or NIL if there is none
+    // (CLRS INTERVAL-SEARCH).
+    //
+    // Time Complexity: O(lg n)
+    //
+    Node* Overlap(const T &low, const T &high) const
+    {
+        Node *x = this->root;
+        while (x != Node::NIL && (high < x->key.low || x->key.high < low))
+            x = x->left != Node::NIL && !(x->left->aug < low) ? x->left : x->right;
+        return x;
+    }
+
+    //
+    // Calls report(interval) for every interval overlapping [low, high], in
+    // order of their low endpoints.
+    //
+    // Time Complexity: O(min(n, (k + 1) lg n)) for k intervals reported
+    //
+    template<typename F>
+    void ForEachOverlap(const T &low, const T &high, F report) const
+    {
+        std::vector<const Node*> stack;
+        const Node *x = this->root;
+        for (;;) {
+            for (; x != Node::NIL && !(x->aug < low); x = x->left)
+                stack.push_back(x);
+            if (stack.empty())
+                return;
+            x = stack.back();
+            stack.pop_back();
+            if (high < x->key.low)
+                return;  // so do all the intervals after it
+            if (!(x->key.high < low))
+                report(x->key);
+            x = x->right;
+        }
+    }
+
+    //
+    // The intervals overlapping [low, high], or containing point, in order
+    // of their low endpoints.
+    //
+    std::vector<Interval<T>> Overlapping(const T &low, const T &high) const
+    {
+        std::vector<Interval<T>> found;
+        ForEachOverlap(low, high, [&](const Interval<T> &i) { found.push_back(i); });
+        return found;
+    }
+
+    std::vector<Interval<T>> Stabbing(const T &point) const
+    {
+        return Overlapping(point, point);
+    }
+};
+
+#endif  /* IntervalTree_hpp */
@@ -0,0 +1,135 @@
+#ifndef KWayMerge_hpp
+#define KWayMerge_hpp
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+//
+// Merges k runs, each sorted by C as for std::merge, with a loser tree: a
+// tournament over the runs in which every internal node remembers the loser
+// of the match played there and the overall winner sits on top. Advancing
+// the winning run replays only the matches on its path to the root, one
+// comparison per level, whereas a heap of run heads pays up to two per level
+// to sift the replacement down. Ties go to the earlier run, so the merge is
+// stable.
+//
+template<typename Iterator,
+         typename C = std::less<typename std::iterator_traits<Iterator>::value_type>>
+class KWayMerge {
+public:
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+
+    //
+    // Time Complexity: O(k)
+    //
+    explicit KWayMerge(std::vector<std::pair<Iterator, Iterator>> runs, const C &c = C());
+
+    //
+    // The next element of the merge. The merge must not be empty.
+    //
+    const value_type& front() const;
+
+    //
+    // Advances past front(), returning the run it came from.
+    //
+    // Time Complexity: O(lg k)
+    //
+    size_t pop();
+
+    bool empty() const;
+
+private:
+    std::vector<std::pair<Iterator, Iterator>> runs_;
+    std::vector<size_t> tree_;  // tree_[0] is the winner, tree_[1..k) losers
+    C comp_;
+
+    bool exhausted(size_t run) const;
+    bool beats(size_t a, size_t b) const;
+};
+
+template<typename Iterator, typename C>
+KWayMerge<Iterator, C>::KWayMerge(std::vector<std::pair<Iterator, Iterator>> runs, const C &c)
+: runs_(std::move(runs)), tree_(runs_.size(), 0), comp_(c)
+{
+    // Play the tournament bottom-up, the leaves k..2k) standing for the runs.
+    const size_t k = runs_.size();
+    std::vector<size_t> winner (2 * k);
+    for (size_t i = 0; i < k; i++)
+        winner[k + i] = i;
+    for (size_t node = k - 1; node > 0 && k > 1; node--) {
+        size_t a = winner[2 * node], b = winner[2 * node + 1];
+        if (beats(b, a))
+            std::swap(a, b);
+        winner[node] = a;
+        tree_[node] = b;
+    }
+    if (k > 1)
+        tree_[0] = winner[1];
+}
+
+template<typename Iterator, typename C>
+const typename KWayMerge<Iterator, C>::value_type& KWayMerge<Iterator, C>::front() const
+{
+    return *runs_[tree_[0]].first;
+}
+
+template<typename Iterator, typename C>
+size_t KWayMerge<Iterator, C>::pop()
+{
+    const size_t run = tree_[0];
+    ++runs_[run].first;
+    size_t w = run;
+    for (size_t node = (runs_.size() + run) / 2; node > 0; node /= 2)
+        if (beats(tree_[node], w))
+            std::swap(tree_[node], w);
+    tree_[0] = w;
+    return run;
+}
+
+template<typename Iterator, typename C>
+bool KWayMerge<Iterator, C>::empty() const
+{
+    return runs_.empty() || exhausted(tree_[0]);
+}
+
+template<typename Iterator, typename C>
+bool KWayMerge<Iterator, C>::exhausted(size_t run) const
+{
+    return runs_[run].first == runs_[run].second;
+}
+
+//
+// Whether run a wins against run b: exhausted runs lose to everything, and
+// ties go to the earlier run.
+//
+template<typename Iterator, typename C>
+bool KWayMerge<Iterator, C>::beats(size_t a, size_t b) const
+{
+    if (exhausted(a))
+        return false;
+    if (exhausted(b))
+        return true;
+    const value_type &x = *runs_[a].first, &y = *runs_[b].first;
+    return comp_(x, y) || (!comp_(y, x) && a < b);
+}
+
+//
+// Merges the runs into out, like std::merge for k inputs.
+//
+// Time Complexity: O(n lg k)
+//
+template<typename Iterator, typename OutputIterator,
+         typename C = std::less<typename std::iterator_traits<Iterator>::value_type>>
+OutputIterator MergeRuns(std::vector<std::pair<Iterator, Iterator>> runs, OutputIterator out,
+                         const C &c = C())
+{
+    KWayMerge<Iterator, C> merge (std::move(runs), c);
+    for (; !merge.empty(); merge.pop())
+        *out++ = merge.front();
+    return out;
+}
+
+#endif  /* KWayMerge_hpp */
@@ -0,0 +1,301 @@
+#ifndef MinMaxHeap_hpp
+#define MinMaxHeap_hpp
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "Vector.hpp"
+
+//
+// A min-max heap (Atkinson et al.) is a double-ended priority queue stored
+// in a Vector<T> like a binary heap. Levels alternate between min levels,
+// starting with the root, and max levels: an element on a min level ranks
+// no higher than anything below it, one on a max level no lower. The minimum
+// is then the root and the maximum one of its two children, so both ends can
+// be served, or evicted, from a single heap in O(lg n).
+//
+// C orders the elements the way it does for Priority_Queue, whose front is
+// the max() of this heap: with the default std::less<T>, min() is the
+// smallest element and max() the largest.
+//
+template<typename T, typename C = std::less<T>>
+class MinMaxHeap {
+public:
+    explicit MinMaxHeap(const C &c = C());
+
+    //
+    // Builds the heap bottom-up, as Priority_Queue does.
+    //
+    // Time Complexity: O(n)
+    //
+    MinMaxHeap(const Vector<T> &v, const C &c = C());
+
+    template<typename InputIterator>
+    MinMaxHeap(InputIterator first, InputIterator last, const C &c = C());
+
+    //
+    // Time Complexity: O(lg n)
+    //
+    void push(const T &elem);
+    void push(T &&elem);
+    template<typename... Args>
+    void emplace(Args&&... args);
+
+    //
+    // Remove and return the smallest or the largest element; they throw on
+    // an empty heap, like Priority_Queue::pop.
+    //
+    // Time Complexity: O(lg n)
+    //
+    T pop_min();
+    T pop_max();
+
+    // Users should check for emptiness beforehand.
+    const T& min() const;
+    const T& max() const;
+
+    bool empty() const;
+    size_t size() const;
+    const Vector<T>& data() const;
+
+private:
+    Vector<T> cont;
+    C comp;
+
+    static bool on_min_level(int idx);
+    int max_index() const;
+    T remove(int idx);
+
+    //
+    // before<false> tells whether a belongs nearer the root on a min level
+    // than b, before<true> the same for a max level.
+    //
+    template<bool Max>
+    bool before(const T &a, const T &b) const
+    {
+        return Max ? comp(b, a) : comp(a, b);
+    }
+
+    template<bool Max>
+    void bubble_up(int hole, T &&elem);
+    template<bool Max>
+    void trickle_down(int hole, T &&elem);
+    void trickle_down(int hole, T &&elem);
+    void make_heap();
+};
+
+template<typename T, typename C>
+MinMaxHeap<T, C>::MinMaxHeap(const C &c)
+: comp(c)
+{
+}
+
+template<typename T, typename C>
+MinMaxHeap<T, C>::MinMaxHeap(const Vector<T> &v, const C &c)
+: comp(c)
+{
+    cont.reserve(v.size());
+    for (size_t i = 0; i < v.size(); i++)
+        cont.push_back(v[i]);
+    make_heap();
+}
+
+template<typename T, typename C>
+template<typename InputIterator>
+MinMaxHeap<T, C>::MinMaxHeap(InputIterator first, InputIterator last, const C &c)
+: comp(c)
+{
+    while (first != last)
+        cont.push_back(*first++);
+    make_heap();
+}
+
+template<typename T, typename C>
+void MinMaxHeap<T, C>::push(const T &elem)
+{
+    push(T(elem));
+}
+
+template<typename T, typename C>
+void MinMaxHeap<T, C>::push(T &&elem)
+{
+    cont.push_back(std::move(elem));
+    int hole = cont.size() - 1;
+    T lifted = std::move(cont[hole]);
+    if (hole == 0) {
+        cont[0] = std::move(lifted);
+        return;
+    }
+    // Against its parent, on the other kind of level, the new element
+    // decides which of the two level chains it climbs.
+    const int parent = (hole - 1) / 2;
+    if (on_min_level(hole)) {
+        if (comp(cont[parent], lifted)) {
+            cont[hole] = std::move(cont[parent]);
+            bubble_up<true>(parent, std::move(lifted));
+        } else {
+            bubble_up<false>(hole, std::move(lifted));
+        }
+    } else {
+        if (comp(lifted, cont[parent])) {
+            cont[hole] = std::move(cont[parent]);
+            bubble_up<false>(parent, std::move(lifted));
+        } else {
+            bubble_up<true>(hole, std::move(lifted));
+        }
+    }
+}
+
+template<typename T, typename C>
+template<typename... Args>
+void MinMaxHeap<T, C>::emplace(Args&&... args)
+{
+    push(T(std::forward<Args>(args)...));
+}
+
+template<typename T, typename C>
+T MinMaxHeap<T, C>::pop_min()
+{
+    if (empty())
+        throw new std::out_of_range("Cannot pop an empty min-max heap.");
+    return remove(0);
+}
+
+template<typename T, typename C>
+T MinMaxHeap<T, C>::pop_max()
+{
+    if (empty())
+        throw new std::out_of_range("Cannot pop an empty min-max heap.");
+    return remove(max_index());
+}
+
+template<typename T, typename C>
+const T& MinMaxHeap<T, C>::min() const
+{
+    return cont[0];
+}
+
+template<typename T, typename C>
+const T& MinMaxHeap<T, C>::max() const
+{
+    return cont[max_index()];
+}
+
+template<typename T, typename C>
+bool MinMaxHeap<T, C>::empty() const
+{
+    return cont.size() == 0;
+}
+
+template<typename T, typename C>
+size_t MinMaxHeap<T, C>::size() const
+{
+    return cont.size();
+}
+
+template<typename T, typename C>
+const Vector<T>& MinMaxHeap<T, C>::data() const
+{
+    return cont;
+}
+
+template<typename T, typename C>
+bool MinMaxHeap<T, C>::on_min_level(int idx)
+{
+    // the level of idx is the position of the highest bit of idx + 1
+    return (31 - __builtin_clz(idx + 1)) % 2 == 0;
+}
+
+template<typename T, typename C>
+int MinMaxHeap<T, C>::max_index() const
+{
+    if (cont.size() < 3)
+        return cont.size() - 1;
+    return comp(cont[1], cont[2]) ? 2 : 1;
+}
+
+//
+// Removes the element at idx, the root or the maximum, refilling its slot
+// with the last element.
+//
+template<typename T, typename C>
+T MinMaxHeap<T, C>::remove(int idx)
+{
+    T top = std::move(cont[idx]);
+    T last = cont.pop_back();
+    if (static_cast<size_t>(idx) < cont.size())
+        trickle_down(idx, std::move(last));
+    return top;
+}
+
+//
+// Moves the hole up through the grandparents, which are on the same kind of
+// level, while elem belongs above them, then fills it.
+//
+template<typename T, typename C>
+template<bool Max>
+void MinMaxHeap<T, C>::bubble_up(int hole, T &&elem)
+{
+    while (hole >= 3) {
+        const int grandparent = (hole - 3) / 4;
+        if (!before<Max>(elem, cont[grandparent]))
+            break;
+        cont[hole] = std::move(cont[grandparent]);
+        hole = grandparent;
+    }
+    cont[hole] = std::move(elem);
+}
+
+//
+// Fills the hole with elem, restoring the heap below it. The hole trades
+// places with the best of the up to six children and grandchildren while
+// that one belongs above elem. Stepping to a grandchild, elem is exchanged
+// with the grandchild's parent if it belongs on that level instead; stepping
+// to a child ends the walk, as a child on the other kind of level with
+// anything below it would have to tie with all of it.
+//
+template<typename T, typename C>
+template<bool Max>
+void MinMaxHeap<T, C>::trickle_down(int hole, T &&elem)
+{
+    const int sz = cont.size();
+    for (int first = 2 * hole + 1; first < sz; first = 2 * hole + 1) {
+        int best = first;
+        if (first + 1 < sz && before<Max>(cont[first + 1], cont[best]))
+            best = first + 1;
+        for (int g = 2 * first + 1, end = std::min(g + 4, sz); g < end; g++)
+            if (before<Max>(cont[g], cont[best]))
+                best = g;
+        if (!before<Max>(cont[best], elem))
+            break;
+        cont[hole] = std::move(cont[best]);
+        hole = best;
+        if (best <= first + 1)
+            break;
+        const int parent = (best - 1) / 2;
+        if (before<Max>(cont[parent], elem))
+            std::swap(cont[parent], elem);
+    }
+    cont[hole] = std::move(elem);
+}
+
+template<typename T, typename C>
+void MinMaxHeap<T, C>::trickle_down(int hole, T &&elem)
+{
+    if (on_min_level(hole))
+        trickle_down<false>(hole, std::move(elem));
+    else
+        trickle_down<true>(hole, std::move(elem));
+}
+
+template<typename T, typename C>
+void MinMaxHeap<T, C>::make_heap()
+{
+    for (int idx = static_cast<int>(cont.size()) / 2 - 1; idx >= 0; --idx) {
+        T elem = std::move(cont[idx]);
+        trickle_down(idx, std::move(elem));
+    }
+}
+
+#endif  /* MinMaxHeap_hpp */
@@ -0,0 +1,283 @@
+#ifndef MultiQueue_hpp
+#define MultiQueue_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Parallel.hpp"
+#include "Priority_Queue.hpp"
+
+//
+// A relaxed concurrent priority queue (Rihani, Sanders and Dementiev's
+// MultiQueue). The elements are spread over c * p Priority_Queue shards for
+// p threads, each guarded by its own spin try-lock:
+//
+//   - push locks a random shard, retrying elsewhere if it is taken;
+//   - try_pop looks at two random shards and pops from the one whose front
+//     ranks higher, again moving on whenever a lock is taken.
+//
+// Threads thus never wait on one another, at the price of popping an
+// element that is only near the front: the expected rank error (how many
+// elements ranked above the one popped) is O(c * p), which a scheduler can
+// usually afford. As with Priority_Queue, the front is the element ranking
+// highest under C, i.e. the greatest with std::less<T>.
+//
+template<typename T, typename C = std::less<T>>
+class MultiQueue {
+public:
+    //
+    // Creates c shards per thread; numThreads <= 0 selects all hardware
+    // threads.
+    //
+    explicit MultiQueue(int numThreads = 0, int c = 2, const C &comp = C());
+
+    //
+    // Inserts elem into a random shard. Safe to call from any thread.
+    //
+    // Time Complexity: O(lg n) expected
+    //
+    void push(T elem);
+
+    //
+    // Pops the higher-ranking front of two random shards into out. Returns
+    // false only if every shard was found empty; concurrent pushes may then
+    // have been missed. Safe to call from any thread.
+    //
+    // Time Complexity: O(lg n) expected
+    //
+    bool try_pop(T &out);
+
+    //
+    // Number of elements, exact only while no other thread is operating.
+    //
+    size_t size() const;
+    bool empty() const;
+
+    int shards() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<bool> locked {false};
+        std::atomic<size_t> size {0};  // mirrors q.size(), readable unlocked
+        Priority_Queue<T, C, 4> q;
+
+        bool try_lock()
+        {
+            return !locked.load(std::memory_order_relaxed) &&
+                !locked.exchange(true, std::memory_order_acquire);
+        }
+        void unlock()
+        {
+            locked.store(false, std::memory_order_release);
+        }
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+    int n_;
+    C comp_;
+
+    Shard& random_shard();
+    bool pop_locked(Shard &s, T &out);
+};
+
+template<typename T, typename C>
+MultiQueue<T, C>::MultiQueue(int numThreads, int c, const C &comp)
+: n_{std::max(1, c) * ResolveThreads(numThreads)}, comp_(comp)
+{
+    shards_.reset(new Shard[n_]);
+    for (int i = 0; i < n_; i++)
+        shards_[i].q = Priority_Queue<T, C, 4>(comp);
+}
+
+template<typename T, typename C>
+void MultiQueue<T, C>::push(T elem)
+{
+    for (;;) {
+        Shard &s = random_shard();
+        if (!s.try_lock())
+            continue;
+        s.q.push(std::move(elem));
+        s.size.store(s.q.size(), std::memory_order_relaxed);
+        s.unlock();
+        return;
+    }
+}
+
+template<typename T, typename C>
+bool MultiQueue<T, C>::try_pop(T &out)
+{
+    for (;;) {
+        Shard *a = &random_shard(), *b = &random_shard();
+        const bool emptyA = a->size.load(std::memory_order_relaxed) == 0;
+        const bool emptyB = b->size.load(std::memory_order_relaxed) == 0;
+        if (emptyA && emptyB) {
+            // Both samples look empty: sweep all shards from a random one
+            // before giving up.
+            const int start = a - shards_.get();
+            Shard *found = nullptr;
+            for (int i = 0; i < n_ && found == nullptr; i++) {
+                Shard &s = shards_[(start + i) % n_];
+                if (s.size.load(std::memory_order_relaxed) != 0)
+                    found = &s;
+            }
+            if (found == nullptr)
+                return false;
+            a = b = found;
+        } else if (emptyA) {
+            a = b;
+        } else if (emptyB) {
+            b = a;
+        }
+
+        if (a == b) {
+            if (a->try_lock() && pop_locked(*a, out))
+                return true;
+            continue;
+        }
+        const bool lockedA = a->try_lock(), lockedB = b->try_lock();
+        if (lockedA && lockedB) {
+            // keep the shard with the better front, if any
+            if (a->q.empty() || (!b->q.empty() && comp_(a->q.front(), b->q.front())))
+                std::swap(a, b);
+            b->unlock();
+        } else if (lockedB) {
+            a = b;
+        } else if (!lockedA) {
+            continue;
+        }
+        if (pop_locked(*a, out))
+            return true;
+    }
+}
+
+template<typename T, typename C>
+size_t MultiQueue<T, C>::size() const
+{
+    size_t total = 0;
+    for (int i = 0; i < n_; i++)
+        total += shards_[i].size.load(std::memory_order_relaxed);
+    return total;
+}
+
+template<typename T, typename C>
+bool MultiQueue<T, C>::empty() const
+{
+    return size() == 0;
+}
+
+template<typename T, typename C>
+int MultiQueue<T, C>::shards() const
+{
+    return n_;
+}
+
+template<typename T, typename C>
+typename MultiQueue<T, C>::Shard& MultiQueue<T, C>::random_shard()
+{
+    // xorshift64*, one stream per thread
+    thread_local std::uint64_t state = 0;
+    if (state == 0)
+        state = reinterpret_cast<std::uintptr_t>(&state) * 0x9E3779B97F4A7C15ull | 1;
+    state ^= state >> 12, state ^= state << 25, state ^= state >> 27;
+    const std::uint64_t r = (state * 0x2545F4914F6CDD1Dull) >> 32;
+    return shards_[(r * static_cast<std::uint64_t>(n_)) >> 32];
+}
+
+//
+// Pops from a shard locked by the caller and unlocks it. Returns false if
+// the shard turned out to be empty.
+//
+template<typename T, typename C>
+bool MultiQueue<T, C>::pop_locked(Shard &s, T &out)
+{
+    const bool popped = !s.q.empty();
+    if (popped) {
+        out = s.q.pop();
+        s.size.store(s.q.size(), std::memory_order_relaxed);
+    }
+    s.unlock();
+    return popped;
+}
+
+//
+// Rank error measurement for relaxed priority queues such as MultiQueue.
+// Threads record every push and pop as a RankEvent stamped with a global
+// clock (e.g. a shared atomic counter bumped right after the operation);
+// MeasureRankError replays the merged log in stamp order and reports, over
+// all pops, the number of elements present at the time that ranked strictly
+// higher than the popped one. An exact priority queue scores 0 throughout.
+//
+template<typename T>
+struct RankEvent {
+    std::uint64_t stamp;
+    bool push;  // false for a pop
+    T value;
+};
+
+struct RankError {
+    double mean {0};
+    std::size_t max {0};
+    std::size_t pops {0};
+};
+
+//
+// Time Complexity: O(m lg m) for m events
+//
+template<typename T, typename C = std::less<T>>
+RankError MeasureRankError(std::vector<RankEvent<T>> events, const C &comp = C())
+{
+    std::sort(events.begin(), events.end(),
+              [](const RankEvent<T> &x, const RankEvent<T> &y) { return x.stamp < y.stamp; });
+
+    // Number the distinct values by rank, lowest first.
+    std::vector<T> values;
+    values.reserve(events.size());
+    for (const RankEvent<T> &e : events)
+        values.push_back(e.value);
+    std::sort(values.begin(), values.end(), comp);
+    values.erase(std::unique(values.begin(), values.end(), [&](const T &x, const T &y) {
+        return !comp(x, y) && !comp(y, x);
+    }), values.end());
+    const std::size_t m = values.size();
+
+    // A Fenwick tree counts the values present at or below every rank.
+    std::vector<std::size_t> tree (m + 1, 0), count (m, 0);
+    auto add = [&](std::size_t i, long long delta) {
+        for (++i; i <= m; i += i & -i)
+            tree[i] += delta;
+    };
+    auto prefix = [&](std::size_t i) {  // present values of rank <= i
+        std::size_t total = 0;
+        for (++i; i > 0; i -= i & -i)
+            total += tree[i];
+        return total;
+    };
+
+    RankError result;
+    std::size_t present = 0;
+    double sum = 0;
+    for (const RankEvent<T> &e : events) {
+        const std::size_t i = std::lower_bound(values.begin(), values.end(), e.value, comp) -
+            values.begin();
+        if (e.push) {
+            ++count[i], ++present;
+            add(i, 1);
+        } else if (count[i] > 0) {  // skip pops the log saw before their push
+            const std::size_t error = present - prefix(i);
+            sum += error;
+            result.max = std::max(result.max, error);
+            ++result.pops;
+            --count[i], --present;
+            add(i, -1);
+        }
+    }
+    result.mean = result.pops > 0 ? sum / result.pops : 0;
+    return result;
+}
+
+#endif  /* MultiQueue_hpp */
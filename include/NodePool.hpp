@@ -0,0 +1,133 @@
+#ifndef NodePool_hpp
+#define NodePool_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//
+// A slab allocator for the nodes of linked data structures. Nodes are carved
+// out of slabs that double in size as the pool grows (up to MAX_SLAB nodes),
+// and freed nodes are kept on an intrusive free list to be handed out again,
+// so a structure that keeps inserting and extracting reaches a steady state
+// without calling malloc or free at all.
+//
+// Nodes never move, hence pointers to them stay valid until they are freed.
+// Destroying the pool releases the slabs without running the destructors of
+// nodes still alive; owners holding nodes that are not trivially
+// destructible must Delete() them first.
+//
+template<typename T>
+class NodePool {
+public:
+    NodePool() = default;
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool(NodePool &&pool) = default;
+    NodePool& operator=(NodePool &&pool) = default;
+
+    //
+    // Constructs a node from the given arguments in a recycled slot, or in
+    // a fresh one if the free list is empty.
+    //
+    // Time Complexity: Amortized O(1)
+    //
+    template<typename... Args>
+    T* New(Args&&... args);
+
+    //
+    // Destroys the node and puts its slot on the free list.
+    //
+    // Time Complexity: O(1)
+    //
+    void Delete(T *node);
+
+    //
+    // Takes over the slabs and free slots of another pool, whose live nodes
+    // may then be freed through this one. The other pool is left empty.
+    //
+    // Time Complexity: O(slabs + free slots of the other pool)
+    //
+    void Merge(NodePool &&pool);
+
+    std::size_t capacity() const;  // slots allocated so far, free or not
+
+private:
+    union Slot {
+        Slot *next;  // while on the free list
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    static constexpr std::size_t MIN_SLAB {64}, MAX_SLAB {1 << 14};
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot *free_ {nullptr};
+    std::size_t used_ {0};      // slots handed out from the newest slab
+    std::size_t slabSize_ {0};  // size of the newest slab
+    std::size_t capacity_ {0};
+};
+
+template<typename T>
+template<typename... Args>
+T* NodePool<T>::New(Args&&... args)
+{
+    Slot *slot = free_;
+    if (slot != nullptr) {
+        free_ = slot->next;
+    } else {
+        if (used_ == slabSize_) {
+            slabSize_ = std::min(std::max(2 * slabSize_, MIN_SLAB), MAX_SLAB);
+            slabs_.emplace_back(new Slot[slabSize_]);
+            capacity_ += slabSize_;
+            used_ = 0;
+        }
+        slot = &slabs_.back()[used_++];
+    }
+    return ::new (static_cast<void*>(slot->bytes)) T(std::forward<Args>(args)...);
+}
+
+template<typename T>
+void NodePool<T>::Delete(T *node)
+{
+    node->~T();
+    Slot *slot = reinterpret_cast<Slot*>(node);
+    slot->next = free_;
+    free_ = slot;
+}
+
+template<typename T>
+void NodePool<T>::Merge(NodePool &&pool)
+{
+    // Whichever newest slab has more uncarved slots stays last, for New()
+    // to go on carving; the few left in the other one are given up on.
+    if (pool.slabSize_ - pool.used_ > slabSize_ - used_) {
+        std::swap(slabs_, pool.slabs_);
+        std::swap(used_, pool.used_);
+        std::swap(slabSize_, pool.slabSize_);
+    }
+    slabs_.insert(slabs_.end() - (slabs_.empty() ? 0 : 1),
+                  std::make_move_iterator(pool.slabs_.begin()),
+                  std::make_move_iterator(pool.slabs_.end()));
+    capacity_ += pool.capacity_;
+    if (pool.free_ != nullptr) {
+        Slot *last = pool.free_;
+        while (last->next != nullptr)
+            last = last->next;
+        last->next = free_;
+        free_ = pool.free_;
+    }
+    pool.slabs_.clear();
+    pool.free_ = nullptr;
+    pool.used_ = pool.slabSize_ = pool.capacity_ = 0;
+}
+
+template<typename T>
+std::size_t NodePool<T>::capacity() const
+{
+    return capacity_;
+}
+
+#endif  /* NodePool_hpp */
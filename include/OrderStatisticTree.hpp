@@ -0,0 +1,81 @@
+#ifndef OrderStatisticTree_hpp
+#define OrderStatisticTree_hpp
+
+#include <cstddef>
+#include <functional>
+#include "RbTree.hpp"
+
+//
+// Augments every node with the number of nodes in its subtree (CLRS 14.1).
+//
+struct RbSubtreeSize {
+    using Data = std::size_t;
+
+    template<typename Node>
+    static void Update(Node *x)
+    {
+        x->aug = x->left->aug + x->right->aug + 1;
+    }
+};
+
+//
+// An RbTree whose nodes know the size of their subtree, which answers order
+// statistic queries over a dynamic set in O(lg n) instead of walking it
+// with Successor.
+//
+template<typename T, typename Compare = std::less<T>, bool Pooled = false>
+class OrderStatisticTree : public RbTree<T, Compare, Pooled, RbSubtreeSize> {
+    using Base = RbTree<T, Compare, Pooled, RbSubtreeSize>;
+public:
+    using Node = typename Base::Node;
+
+    //
+    // The node with the i-th smallest key, counting from 1, or NIL if the
+    // tree has fewer than i nodes.
+    //
+    // Time Complexity: O(lg n)
+    //
+    Node* Select(std::size_t i) const
+    {
+        Node *x = this->root;
+        while (x != Node::NIL) {
+            const std::size_t r = x->left->aug + 1;
+            if (i == r)
+                return x;
+            if (i < r) {
+                x = x->left;
+            } else {
+                x = x->right;
+                i -= r;
+            }
+        }
+        return x;
+    }
+
+    //
+    // The number of keys ordered before key; Select(Rank(key) + 1) is then
+    // the first node not ordered before key.
+    //
+    // Time Complexity: O(lg n)
+    //
+    std::size_t Rank(const T &key) const
+    {
+        std::size_t rank = 0;
+        for (const Node *x = this->root; x != Node::NIL; ) {
+            if (this->comp(x->key, key)) {
+                rank += x->left->aug + 1;
+                x = x->right;
+            } else {
+                x = x->left;
+            }
+        }
+        return rank;
+    }
+
+    std::size_t Size() const
+    {
+        return this->root->aug;
+    }
+};
+
+#endif  /* OrderStatisticTree_hpp */
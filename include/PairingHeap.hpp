@@ -0,0 +1,321 @@
+#ifndef PairingHeap_hpp
+#define PairingHeap_hpp
+
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "NodePool.hpp"
+
+//
+// A Pairing Heap is a single heap-ordered multiway tree. INSERT, UNION and
+// DECREASE-KEY simply link two trees, making the root with the larger key
+// the leftmost child of the other; all restructuring is deferred to
+// EXTRACT-MIN, which melds the children of the old root in two passes:
+// pairwise from left to right, then the pairs from right to left.
+//
+// The bounds are weaker than those of a Fibonacci heap on paper (DECREASE-KEY
+// costs amortized O(lg n) in the worst case, though it is believed to be
+// o(lg n)), but the nodes are smaller, the code paths are shorter and there
+// is no consolidation table, so pairing heaps tend to win in practice.
+//
+// The interface is the one of FibHeap: entries pair a Key with a Value,
+// Insert returns a Handle valid until the entry leaves the heap, and nodes
+// are recycled through a NodePool.
+//
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+class PairingHeap {
+    //
+    // Children form a doubly-linked list through next and prev, where the
+    // prev of the leftmost child points to the parent instead.
+    //
+    struct Node {
+        Key key;
+        Value value;
+        Node *child {nullptr};
+        Node *next {nullptr};
+        Node *prev {nullptr};
+
+        Node(Key &&_key, Value &&_value) : key{std::move(_key)}, value{std::move(_value)} {}
+    };
+
+public:
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool operator==(const Handle &h) const
+        {
+            return node_ == h.node_;
+        }
+        bool operator!=(const Handle &h) const
+        {
+            return node_ != h.node_;
+        }
+
+    private:
+        friend class PairingHeap;
+        explicit Handle(Node *node) : node_{node} {}
+        Node *node_ {nullptr};
+    };
+
+    explicit PairingHeap(const Compare &comp = Compare()) : comp_{comp} {}
+    PairingHeap(const PairingHeap&) = delete;
+    PairingHeap& operator=(const PairingHeap&) = delete;
+
+    //
+    // Links a single-node tree with the root.
+    //
+    // Time Complexity: O(1)
+    //
+    Handle Insert(Key key, Value value);
+
+    //
+    // Links the root of h with ours; the handles into h remain valid. The
+    // unioned heap is left empty.
+    //
+    // Time Complexity: O(1), plus O(free nodes of h) to adopt them
+    //
+    void Union(PairingHeap&& h);
+
+    //
+    // Extracts the entry with the minimum key and returns its key and value.
+    // The heap must not be empty.
+    //
+    // Time Complexity: Amortized O(lg n)
+    //
+    std::pair<Key, Value> ExtractMin();
+
+    //
+    // Decreases the key of an entry by cutting its subtree loose and linking
+    // it with the root; keys that do not come before the current one are
+    // ignored.
+    //
+    // Time Complexity: O(1), amortized O(lg n) in the worst case
+    //
+    void DecreaseKey(Handle h, Key decreasedKey);
+
+    //
+    // Removes an entry from the heap, whatever its key.
+    //
+    // Time Complexity: Amortized O(lg n)
+    //
+    void Delete(Handle h);
+
+    ~PairingHeap();
+
+    // Accessors
+
+    int size() const;
+    bool empty() const;
+
+    // Users should check for emptiness beforehand.
+    const Key& minKey() const;
+    const Value& minValue() const;
+
+    const Key& key(Handle h) const;
+    Value& value(Handle h);
+    const Value& value(Handle h) const;
+
+private:
+    int size_ {0};
+    Node *root_ {nullptr};
+    Compare comp_;
+    NodePool<Node> pool_;
+
+    Node* Link(Node *a, Node *b);
+    Node* CombineSiblings(Node *first);
+    static void Cut(Node *node);
+};
+
+template<typename Key, typename Value, typename Compare>
+typename PairingHeap<Key, Value, Compare>::Handle
+PairingHeap<Key, Value, Compare>::Insert(Key key, Value value)
+{
+    Node *node = pool_.New(std::move(key), std::move(value));
+    root_ = root_ == nullptr ? node : Link(root_, node);
+    ++size_;
+    return Handle(node);
+}
+
+template<typename Key, typename Value, typename Compare>
+void PairingHeap<Key, Value, Compare>::Union(PairingHeap&& h)
+{
+    pool_.Merge(std::move(h.pool_));
+    if (h.root_ == nullptr)
+        return;
+    root_ = root_ == nullptr ? h.root_ : Link(root_, h.root_);
+    size_ += h.size_;
+
+    h.size_ = 0;
+    h.root_ = nullptr;
+}
+
+template<typename Key, typename Value, typename Compare>
+std::pair<Key, Value> PairingHeap<Key, Value, Compare>::ExtractMin()
+{
+    Node *z = root_;
+    root_ = CombineSiblings(z->child);
+    --size_;
+    std::pair<Key, Value> entry (std::move(z->key), std::move(z->value));
+    pool_.Delete(z);
+    return entry;
+}
+
+template<typename Key, typename Value, typename Compare>
+void PairingHeap<Key, Value, Compare>::DecreaseKey(Handle h, Key decreasedKey)
+{
+    Node *node = h.node_;
+    if (!comp_(decreasedKey, node->key))
+        return;
+    node->key = std::move(decreasedKey);
+    if (node != root_) {
+        Cut(node);
+        root_ = Link(root_, node);
+    }
+}
+
+template<typename Key, typename Value, typename Compare>
+void PairingHeap<Key, Value, Compare>::Delete(Handle h)
+{
+    Node *node = h.node_;
+    if (node == root_) {
+        root_ = CombineSiblings(node->child);
+    } else {
+        Cut(node);
+        if (Node *rest = CombineSiblings(node->child))
+            root_ = Link(root_, rest);
+    }
+    --size_;
+    pool_.Delete(node);
+}
+
+template<typename Key, typename Value, typename Compare>
+PairingHeap<Key, Value, Compare>::~PairingHeap()
+{
+    if (std::is_trivially_destructible<Node>::value)
+        return;  // pool_ releases the memory
+    // Walk the nodes as a chain through next, splicing the children of
+    // every node in right behind it before it is destroyed.
+    for (Node *x = root_, *next; x != nullptr; x = next) {
+        if (Node *c = x->child) {
+            Node *last = c;
+            while (last->next != nullptr)
+                last = last->next;
+            last->next = x->next;
+            x->next = c;
+        }
+        next = x->next;
+        pool_.Delete(x);
+    }
+}
+
+template<typename Key, typename Value, typename Compare>
+int PairingHeap<Key, Value, Compare>::size() const
+{
+    return size_;
+}
+
+template<typename Key, typename Value, typename Compare>
+bool PairingHeap<Key, Value, Compare>::empty() const
+{
+    return size_ == 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Key& PairingHeap<Key, Value, Compare>::minKey() const
+{
+    return root_->key;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Value& PairingHeap<Key, Value, Compare>::minValue() const
+{
+    return root_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Key& PairingHeap<Key, Value, Compare>::key(Handle h) const
+{
+    return h.node_->key;
+}
+
+template<typename Key, typename Value, typename Compare>
+Value& PairingHeap<Key, Value, Compare>::value(Handle h)
+{
+    return h.node_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Value& PairingHeap<Key, Value, Compare>::value(Handle h) const
+{
+    return h.node_->value;
+}
+
+//
+// Links two roots, returning the new root; the loser becomes its leftmost
+// child. The siblings of the winner are left untouched.
+//
+template<typename Key, typename Value, typename Compare>
+typename PairingHeap<Key, Value, Compare>::Node*
+PairingHeap<Key, Value, Compare>::Link(Node *a, Node *b)
+{
+    if (comp_(b->key, a->key))
+        std::swap(a, b);
+    b->prev = a;
+    b->next = a->child;
+    if (a->child != nullptr)
+        a->child->prev = b;
+    a->child = b;
+    return a;
+}
+
+//
+// Melds a list of siblings into one tree with the two-pass method, without
+// recursion: the first pass links pairs from left to right, stacking the
+// results through next; the second pops them, linking right to left.
+//
+template<typename Key, typename Value, typename Compare>
+typename PairingHeap<Key, Value, Compare>::Node*
+PairingHeap<Key, Value, Compare>::CombineSiblings(Node *first)
+{
+    if (first == nullptr)
+        return nullptr;
+    Node *pairs = nullptr;
+    while (first != nullptr) {
+        Node *a = first, *b = a->next;
+        if (b == nullptr) {
+            a->next = pairs;
+            pairs = a;
+            break;
+        }
+        first = b->next;
+        Node *linked = Link(a, b);
+        linked->next = pairs;
+        pairs = linked;
+    }
+    Node *root = pairs;
+    for (Node *x = pairs->next, *next; x != nullptr; x = next) {
+        next = x->next;
+        root = Link(root, x);
+    }
+    root->next = root->prev = nullptr;
+    return root;
+}
+
+//
+// Detaches a non-root node, with its subtree, from its parent and siblings.
+//
+template<typename Key, typename Value, typename Compare>
+void PairingHeap<Key, Value, Compare>::Cut(Node *node)
+{
+    if (node->prev->child == node)
+        node->prev->child = node->next;
+    else
+        node->prev->next = node->next;
+    if (node->next != nullptr)
+        node->next->prev = node->prev;
+    node->next = node->prev = nullptr;
+}
+
+#endif  /* PairingHeap_hpp */
@@ -0,0 +1,55 @@
+#ifndef Parallel_hpp
+#define Parallel_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+//
+// Resolves a requested thread count. Non-positive values select the number
+// of hardware threads, falling back to one when that cannot be determined.
+//
+inline int ResolveThreads(int numThreads)
+{
+    if (numThreads > 0)
+        return numThreads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//
+// Splits the index range [0, n) into chunks of `grain` indices that are
+// handed out dynamically to `numThreads` workers, calling fn(tid, first, last)
+// for every chunk. Dynamic scheduling keeps skewed workloads (such as
+// vertices of wildly different degrees) balanced. The calling thread acts as
+// worker 0, so a single thread never spawns anything.
+//
+template<typename F>
+void ParallelFor(std::size_t n, int numThreads, std::size_t grain, F fn)
+{
+    numThreads = ResolveThreads(numThreads);
+    grain = std::max<std::size_t>(grain, 1);
+    if (numThreads == 1 || n <= grain) {
+        if (n > 0)
+            fn(0, std::size_t{0}, n);
+        return;
+    }
+    std::atomic<std::size_t> next {0};
+    auto work = [&](int tid) {
+        for (;;) {
+            std::size_t first = next.fetch_add(grain, std::memory_order_relaxed);
+            if (first >= n)
+                break;
+            fn(tid, first, std::min(n, first + grain));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int tid = 1; tid < numThreads; tid++)
+        workers.emplace_back(work, tid);
+    work(0);
+    for (std::thread &t : workers)
+        t.join();
+}
+
+#endif  /* Parallel_hpp */
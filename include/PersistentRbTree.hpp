@@ -0,0 +1,320 @@
+#ifndef PersistentRbTree_hpp
+#define PersistentRbTree_hpp
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "RbTree.hpp"  // Color
+
+//
+// A persistent red-black set: nodes are never modified once built, so an
+// update copies the O(lg n) nodes on the path it changes and shares every
+// other subtree with the version before it. Copying a tree is therefore an
+// O(1) snapshot, unaffected by later updates to either copy.
+//
+// Insertion rebalances as in Okasaki's functional red-black trees, deletion
+// as in Kahrs'. Nodes are reference counted through std::shared_ptr and are
+// freed with the last version that uses them. The counts are atomic, so
+// snapshots may be handed to other threads and read there while the writer
+// keeps updating its own copy; a single tree object is not thread-safe.
+//
+template<typename T, typename Compare = std::less<T>>
+class PersistentRbTree {
+public:
+    struct Node;
+    using Ptr = std::shared_ptr<const Node>;
+
+    struct Node {
+        T key;
+        Color color;
+        Ptr left;
+        Ptr right;
+    };
+
+    using value_type = T;
+
+    explicit PersistentRbTree(const Compare &comp = Compare()) : comp(comp) {}
+
+    //
+    // Inserts key unless it is present, returning whether it was inserted.
+    //
+    // Time Complexity: O(lg n), allocating O(lg n) nodes
+    //
+    bool Insert(const T &key)
+    {
+        if (Search(key) != nullptr)
+            return false;
+        this->root = Blackened(Insert(this->root, key));
+        ++this->size;
+        return true;
+    }
+
+    //
+    // Erases key, returning whether it was present.
+    //
+    // Time Complexity: O(lg n), allocating O(lg n) nodes
+    //
+    bool Erase(const T &key)
+    {
+        if (Search(key) == nullptr)
+            return false;
+        this->root = Delete(this->root, key);
+        if (this->root != nullptr)
+            this->root = Blackened(this->root);
+        --this->size;
+        return true;
+    }
+
+    //
+    // The key equal to key, or nullptr. It stays valid as long as some
+    // version holding it does.
+    //
+    // Time Complexity: O(lg n)
+    //
+    const T* Search(const T &key) const
+    {
+        for (const Node *x = this->root.get(); x != nullptr; ) {
+            if (comp(key, x->key))
+                x = x->left.get();
+            else if (comp(x->key, key))
+                x = x->right.get();
+            else
+                return &x->key;
+        }
+        return nullptr;
+    }
+
+    bool Contains(const T &key) const
+    {
+        return Search(key) != nullptr;
+    }
+
+    // The first key not ordered before key, or nullptr.
+    const T* LowerBound(const T &key) const
+    {
+        const T *best = nullptr;
+        for (const Node *x = this->root.get(); x != nullptr; ) {
+            if (!comp(x->key, key)) {
+                best = &x->key;
+                x = x->left.get();
+            } else {
+                x = x->right.get();
+            }
+        }
+        return best;
+    }
+
+    const T* Minimum() const
+    {
+        const Node *x = this->root.get();
+        if (x == nullptr)
+            return nullptr;
+        while (x->left != nullptr)
+            x = x->left.get();
+        return &x->key;
+    }
+
+    const T* Maximum() const
+    {
+        const Node *x = this->root.get();
+        if (x == nullptr)
+            return nullptr;
+        while (x->right != nullptr)
+            x = x->right.get();
+        return &x->key;
+    }
+
+    //
+    // Calls visit(key) for every key in order.
+    //
+    // Time Complexity: O(n)
+    //
+    template<typename F>
+    void ForEach(F visit) const
+    {
+        ForEach(this->root.get(), visit);
+    }
+
+    std::size_t Size() const
+    {
+        return this->size;
+    }
+
+    bool Empty() const
+    {
+        return this->size == 0;
+    }
+
+    const Node* Root() const
+    {
+        return this->root.get();
+    }
+
+    // Whether the two versions share their whole tree.
+    bool SharesRoot(const PersistentRbTree &t) const
+    {
+        return this->root == t.root;
+    }
+
+private:
+    Ptr root;
+    std::size_t size {0};
+    Compare comp;
+
+    static Ptr Make(Color color, Ptr left, const T &key, Ptr right)
+    {
+        return std::make_shared<const Node>(Node{key, color, std::move(left), std::move(right)});
+    }
+
+    static bool IsRed(const Ptr &x)
+    {
+        return x != nullptr && x->color == Color::RED;
+    }
+
+    static bool IsBlack(const Ptr &x)  // and not a leaf
+    {
+        return x != nullptr && x->color == Color::BLACK;
+    }
+
+    static Ptr Blackened(const Ptr &x)
+    {
+        return x->color == Color::BLACK ? x : Make(Color::BLACK, x->left, x->key, x->right);
+    }
+
+    static Ptr Reddened(const Ptr &x)
+    {
+        if (!IsBlack(x))
+            throw new std::logic_error("Red-black invariant violated.");
+        return Make(Color::RED, x->left, x->key, x->right);
+    }
+
+    //
+    // A black node over a, x and b, rotated into a red node with two black
+    // children when it would have a red child with a red child.
+    //
+    static Ptr Balance(const Ptr &a, const T &x, const Ptr &b)
+    {
+        if (IsRed(a) && IsRed(b))
+            return Make(Color::RED, Blackened(a), x, Blackened(b));
+        if (IsRed(a) && IsRed(a->left))
+            return Make(Color::RED, Blackened(a->left), a->key,
+                        Make(Color::BLACK, a->right, x, b));
+        if (IsRed(a) && IsRed(a->right))
+            return Make(Color::RED, Make(Color::BLACK, a->left, a->key, a->right->left),
+                        a->right->key, Make(Color::BLACK, a->right->right, x, b));
+        if (IsRed(b) && IsRed(b->right))
+            return Make(Color::RED, Make(Color::BLACK, a, x, b->left), b->key,
+                        Blackened(b->right));
+        if (IsRed(b) && IsRed(b->left))
+            return Make(Color::RED, Make(Color::BLACK, a, x, b->left->left), b->left->key,
+                        Make(Color::BLACK, b->left->right, b->key, b->right));
+        return Make(Color::BLACK, a, x, b);
+    }
+
+    // Inserts the absent key into t; the root may come back red.
+    Ptr Insert(const Ptr &t, const T &key) const
+    {
+        if (t == nullptr)
+            return Make(Color::RED, nullptr, key, nullptr);
+        if (comp(key, t->key)) {
+            Ptr left = Insert(t->left, key);
+            return t->color == Color::BLACK ? Balance(left, t->key, t->right)
+                                            : Make(Color::RED, left, t->key, t->right);
+        }
+        Ptr right = Insert(t->right, key);
+        return t->color == Color::BLACK ? Balance(t->left, t->key, right)
+                                        : Make(Color::RED, t->left, t->key, right);
+    }
+
+    //
+    // Rebuilds a node whose left subtree lost one black level.
+    //
+    static Ptr BalanceLeft(const Ptr &left, const T &x, const Ptr &right)
+    {
+        if (IsRed(left))
+            return Make(Color::RED, Blackened(left), x, right);
+        if (IsBlack(right))
+            return Balance(left, x, Reddened(right));
+        if (IsRed(right) && IsBlack(right->left))
+            return Make(Color::RED, Make(Color::BLACK, left, x, right->left->left),
+                        right->left->key,
+                        Balance(right->left->right, right->key, Reddened(right->right)));
+        throw new std::logic_error("Red-black invariant violated.");
+    }
+
+    static Ptr BalanceRight(const Ptr &left, const T &x, const Ptr &right)
+    {
+        if (IsRed(right))
+            return Make(Color::RED, left, x, Blackened(right));
+        if (IsBlack(left))
+            return Balance(Reddened(left), x, right);
+        if (IsRed(left) && IsBlack(left->right))
+            return Make(Color::RED,
+                        Balance(Reddened(left->left), left->key, left->right->left),
+                        left->right->key,
+                        Make(Color::BLACK, left->right->right, x, right));
+        throw new std::logic_error("Red-black invariant violated.");
+    }
+
+    //
+    // Concatenates the subtrees of a deleted node, all of a's keys coming
+    // before b's.
+    //
+    static Ptr Append(const Ptr &a, const Ptr &b)
+    {
+        if (a == nullptr)
+            return b;
+        if (b == nullptr)
+            return a;
+        if (IsRed(a) && IsRed(b)) {
+            Ptr bc = Append(a->right, b->left);
+            if (IsRed(bc))
+                return Make(Color::RED, Make(Color::RED, a->left, a->key, bc->left), bc->key,
+                            Make(Color::RED, bc->right, b->key, b->right));
+            return Make(Color::RED, a->left, a->key, Make(Color::RED, bc, b->key, b->right));
+        }
+        if (IsBlack(a) && IsBlack(b)) {
+            Ptr bc = Append(a->right, b->left);
+            if (IsRed(bc))
+                return Make(Color::RED, Make(Color::BLACK, a->left, a->key, bc->left), bc->key,
+                            Make(Color::BLACK, bc->right, b->key, b->right));
+            return BalanceLeft(a->left, a->key, Make(Color::BLACK, bc, b->key, b->right));
+        }
+        if (IsRed(b))
+            return Make(Color::RED, Append(a, b->left), b->key, b->right);
+        return Make(Color::RED, a->left, a->key, Append(a->right, b));
+    }
+
+    //
+    // Deletes the present key from t. A black t comes back one black level
+    // shorter, which its parent rebalances.
+    //
+    Ptr Delete(const Ptr &t, const T &key) const
+    {
+        if (comp(key, t->key)) {
+            if (IsBlack(t->left))
+                return BalanceLeft(Delete(t->left, key), t->key, t->right);
+            return Make(Color::RED, Delete(t->left, key), t->key, t->right);
+        }
+        if (comp(t->key, key)) {
+            if (IsBlack(t->right))
+                return BalanceRight(t->left, t->key, Delete(t->right, key));
+            return Make(Color::RED, t->left, t->key, Delete(t->right, key));
+        }
+        return Append(t->left, t->right);
+    }
+
+    template<typename F>
+    static void ForEach(const Node *x, F &visit)
+    {
+        if (x == nullptr)
+            return;
+        ForEach(x->left.get(), visit);
+        visit(x->key);
+        ForEach(x->right.get(), visit);
+    }
+};
+
+#endif  /* PersistentRbTree_hpp */
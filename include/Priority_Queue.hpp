@@ -8,13 +8,28 @@
 #ifndef Priority_Queue_hpp
 #define Priority_Queue_hpp
 
+#include <algorithm>
 #include <functional>
 #include <exception>
+#include <stdexcept>
 #include "Vector.hpp"
 
-template<typename T, typename C = std::less<T>>
+//
+// A D-ary heap stored in a Vector<T>. The default D = 2 is the classic binary
+// heap; wider heaps (D = 4 or 8) are shallower, so a dequeue on a large heap
+// walks fewer levels, each of which costs a cache miss, at the price of more
+// comparisons per level.
+//
+// For D > 2 the root is stored at cont[D - 1], which puts the children of
+// every node in a group cont[D * k .. D * k + D) starting at a multiple of D:
+// when D * sizeof(T) is 64 (e.g. 16 ints, 8 pointers or doubles) and the
+// buffer is cache-line aligned, every sibling group is one cache line. The
+// D - 1 slots in front are padding, which data() exposes.
+//
+template<typename T, typename C = std::less<T>, size_t D = 2>
 class Priority_Queue {
     // NOTE: using std::less<T> as C yields a max heap (not a min heap)
+    static_assert(D >= 2, "a heap node needs at least two children");
 public:
     explicit Priority_Queue(const C &c = C());
     Priority_Queue(const Vector<T> &v, const C &c = C());
@@ -31,6 +46,39 @@ public:
     void enqueue(T elem);
     T dequeue();
 
+    //
+    // Move-aware counterparts of enqueue and dequeue: push(T&&) and emplace
+    // never copy the element, and pop moves it out. All sifting moves a hole
+    // through the heap instead of swapping, so every level costs one move
+    // rather than the three of a swap.
+    //
+    // Time Complexity: O(log_D n) for pushes, O(D log_D n) for pop
+    //
+    void push(const T &elem);
+    void push(T &&elem);
+    template<typename... Args>
+    void emplace(Args&&... args);
+    T pop();
+
+    //
+    // Replaces the top element with elem and returns the old top, with a
+    // single sift-down instead of a pop followed by a push. The queue must
+    // not be empty.
+    //
+    // Time Complexity: O(D log_D n)
+    //
+    T replace_top(T elem);
+
+    //
+    // Pushes elem and pops the top, returning it; when elem itself would be
+    // the top it is returned at once, leaving the heap untouched. A heap of
+    // k elements fed through pushpop keeps the k lowest-ranked ones seen,
+    // as top-k selection and k-way merging need.
+    //
+    // Time Complexity: O(D log_D n)
+    //
+    T pushpop(T elem);
+
     const T& front() const;
     T& front();
 
@@ -44,52 +92,59 @@ private:
     Vector<T> cont;
     C comp;
 
+    static constexpr int ROOT = D > 2 ? D - 1 : 0;  // index of the root in cont
+
     static inline int parent(int idx);
-    static inline int left(int idx);
-    static inline int right(int idx);
+    static inline int child(int idx);  // the first of the D children
 
-    static void heapify(Priority_Queue &q, int idx);
+    static void sift_up(Priority_Queue &q, int hole, int top, T &&elem);
+    static void sift_down(Priority_Queue &q, int hole, T &&elem);
     static void make_heap(Priority_Queue &q);
 };
 
-template<typename T, typename C>
-Priority_Queue<T, C>::Priority_Queue(const C &c)
+template<typename T, typename C, size_t D>
+Priority_Queue<T, C, D>::Priority_Queue(const C &c)
+: comp(c)
 {
-    cont = Vector<T>();
-    comp = c;
+    cont.resize(ROOT);  // default-constructed padding, so T need not be copyable
 }
 
-template<typename T, typename C>
-Priority_Queue<T, C>::Priority_Queue(const Vector<T> &v, const C &c)
-: cont(v), comp(c)
+template<typename T, typename C, size_t D>
+Priority_Queue<T, C, D>::Priority_Queue(const Vector<T> &v, const C &c)
+: cont(ROOT), comp(c)
 {
+    cont.reserve(ROOT + v.size());
+    for (size_t i = 0; i < v.size(); i++)
+        cont.push_back(v[i]);
     make_heap(*this);
 }
 
-template<typename T, typename C>
+template<typename T, typename C, size_t D>
 template<typename InputIterator>
-Priority_Queue<T, C>::Priority_Queue(InputIterator first, InputIterator last, const C &c)
-: cont(first, last), comp(c)
+Priority_Queue<T, C, D>::Priority_Queue(InputIterator first, InputIterator last, const C &c)
+: cont(ROOT), comp(c)
 {
+    while (first != last)
+        cont.push_back(*first++);
     make_heap(*this);
 }
 
-template<typename T, typename C>
-Priority_Queue<T, C>::Priority_Queue(const Priority_Queue<T, C> &q)
+template<typename T, typename C, size_t D>
+Priority_Queue<T, C, D>::Priority_Queue(const Priority_Queue<T, C, D> &q)
 {
     cont = q.cont;
     comp = q.comp;
 }
 
-template<typename T, typename C>
-Priority_Queue<T, C>::Priority_Queue(Priority_Queue<T, C> &&q)
+template<typename T, typename C, size_t D>
+Priority_Queue<T, C, D>::Priority_Queue(Priority_Queue<T, C, D> &&q)
 {
     cont = std::move(q.cont);
     comp = q.comp;
 }
 
-template<typename T, typename C>
-Priority_Queue<T, C>& Priority_Queue<T, C>::operator=(const Priority_Queue<T, C> &q)
+template<typename T, typename C, size_t D>
+Priority_Queue<T, C, D>& Priority_Queue<T, C, D>::operator=(const Priority_Queue<T, C, D> &q)
 {
     if (this == &q)
         return *this;
@@ -98,8 +153,8 @@ Priority_Queue<T, C>& Priority_Queue<T, C>::operator=(const Priority_Queue<T, C>
     return *this;
 }
 
-template<typename T, typename C>
-Priority_Queue<T, C>& Priority_Queue<T, C>::operator=(Priority_Queue<T, C> &&q)
+template<typename T, typename C, size_t D>
+Priority_Queue<T, C, D>& Priority_Queue<T, C, D>::operator=(Priority_Queue<T, C, D> &&q)
 {
     if (this == &q)
         return *this;
@@ -108,103 +163,158 @@ Priority_Queue<T, C>& Priority_Queue<T, C>::operator=(Priority_Queue<T, C> &&q)
     return *this;
 }
 
-template<typename T, typename C>
-void Priority_Queue<T, C>::enqueue(T elem)
+template<typename T, typename C, size_t D>
+void Priority_Queue<T, C, D>::enqueue(T elem)
 {
-    cont.push_back(elem);
-    int idx = cont.size() - 1;
-    while (idx > 0 && comp(cont[parent(idx)], elem)) {
-        cont[idx] = cont[parent(idx)];
-        idx = parent(idx);
-    }
-    cont[idx] = elem;
+    push(std::move(elem));
+}
+
+template<typename T, typename C, size_t D>
+T Priority_Queue<T, C, D>::dequeue()
+{
+    return pop();
+}
+
+template<typename T, typename C, size_t D>
+void Priority_Queue<T, C, D>::push(const T &elem)
+{
+    push(T(elem));
+}
+
+template<typename T, typename C, size_t D>
+void Priority_Queue<T, C, D>::push(T &&elem)
+{
+    // grow the storage, then lift the new element out to leave a hole
+    cont.push_back(std::move(elem));
+    int hole = cont.size() - 1;
+    T lifted = std::move(cont[hole]);
+    sift_up(*this, hole, ROOT, std::move(lifted));
 }
 
-template<typename T, typename C>
-T Priority_Queue<T, C>::dequeue()
+template<typename T, typename C, size_t D>
+template<typename... Args>
+void Priority_Queue<T, C, D>::emplace(Args&&... args)
 {
-    if (cont.size() == 0)
+    push(T(std::forward<Args>(args)...));
+}
+
+template<typename T, typename C, size_t D>
+T Priority_Queue<T, C, D>::pop()
+{
+    if (empty())
         throw new std::out_of_range("Cannot dequeue an empty priority queue.");
 
-    if (cont.size() == 1)
-        return cont.pop_back();
+    T top = std::move(cont[ROOT]);
+    T last = cont.pop_back();
+    if (!empty())
+        sift_down(*this, ROOT, std::move(last));
+    return top;
+}
+
+template<typename T, typename C, size_t D>
+T Priority_Queue<T, C, D>::replace_top(T elem)
+{
+    T top = std::move(cont[ROOT]);
+    sift_down(*this, ROOT, std::move(elem));
+    return top;
+}
 
-    T elem = cont.front();
-    std::swap(cont.front(), cont.back());
-    cont.pop_back();
-    heapify(*this, 0);
-    return elem;
+template<typename T, typename C, size_t D>
+T Priority_Queue<T, C, D>::pushpop(T elem)
+{
+    if (empty() || comp(cont[ROOT], elem))
+        return elem;
+    return replace_top(std::move(elem));
 }
 
-template<typename T, typename C>
-const T& Priority_Queue<T, C>::front() const
+template<typename T, typename C, size_t D>
+const T& Priority_Queue<T, C, D>::front() const
 {
-    return cont.front();
+    return cont[ROOT];
 }
 
-template<typename T, typename C>
-T& Priority_Queue<T, C>::front()
+template<typename T, typename C, size_t D>
+T& Priority_Queue<T, C, D>::front()
 {
-    return cont.front();
+    return cont[ROOT];
 }
 
-template<typename T, typename C>
-bool Priority_Queue<T, C>::empty() const
+template<typename T, typename C, size_t D>
+bool Priority_Queue<T, C, D>::empty() const
 {
-    return cont.size() == 0;
+    return cont.size() == static_cast<size_t>(ROOT);
 }
 
-template<typename T, typename C>
-size_t Priority_Queue<T, C>::size() const
+template<typename T, typename C, size_t D>
+size_t Priority_Queue<T, C, D>::size() const
 {
-    return cont.size();
+    return cont.size() - ROOT;
 }
 
-template<typename T, typename C>
-const Vector<T>& Priority_Queue<T, C>::data() const
+template<typename T, typename C, size_t D>
+const Vector<T>& Priority_Queue<T, C, D>::data() const
 {
     return cont;
 }
 
-template<typename T, typename C>
-inline int Priority_Queue<T, C>::parent(int idx)
+template<typename T, typename C, size_t D>
+inline int Priority_Queue<T, C, D>::parent(int idx)
 {
-    return ((idx + 1) / 2) - 1;
+    return (idx - ROOT - 1) / static_cast<int>(D) + ROOT;
 }
 
-template<typename T, typename C>
-inline int Priority_Queue<T, C>::left(int idx)
+template<typename T, typename C, size_t D>
+inline int Priority_Queue<T, C, D>::child(int idx)
 {
-    return 2 * idx + 1;
+    return static_cast<int>(D) * (idx - ROOT) + 1 + ROOT;
 }
 
-template<typename T, typename C>
-inline int Priority_Queue<T, C>::right(int idx)
+//
+// Moves the hole up, no higher than top, while its parent ranks below elem,
+// then fills it.
+//
+template<typename T, typename C, size_t D>
+void Priority_Queue<T, C, D>::sift_up(Priority_Queue<T, C, D> &q, int hole, int top, T &&elem)
 {
-    return 2 * idx + 2;
+    while (hole > top && q.comp(q.cont[parent(hole)], elem)) {
+        q.cont[hole] = std::move(q.cont[parent(hole)]);
+        hole = parent(hole);
+    }
+    q.cont[hole] = std::move(elem);
 }
 
-template<typename T, typename C>
-void Priority_Queue<T, C>::heapify(Priority_Queue<T, C> &q, int idx)
+//
+// Fills the hole with elem, restoring the heap below it. Following Floyd,
+// the hole first sinks all the way to a leaf along the highest-ranked
+// children, without comparing against elem, and elem then rises from there
+// (rarely far, as it usually came from the bottom). This saves the one
+// comparison per level that the textbook sift-down spends on elem.
+//
+template<typename T, typename C, size_t D>
+void Priority_Queue<T, C, D>::sift_down(Priority_Queue<T, C, D> &q, int hole, T &&elem)
 {
-    int pidx = idx, sz = q.cont.size();
-    while (idx < sz) {
-        if (left(idx) < sz && q.comp(q.cont[pidx], q.cont[left(idx)]))
-            pidx = left(idx);
-        if (right(idx) < sz && q.comp(q.cont[pidx], q.cont[right(idx)]))
-            pidx = right(idx);
-        if (pidx == idx) break;
-        std::swap(q.cont[pidx], q.cont[idx]);
-        idx = pidx;
+    const int top = hole, sz = q.cont.size();
+    for (int first = child(hole); first < sz; first = child(hole)) {
+        int best = first, last = std::min(first + static_cast<int>(D), sz);
+        for (int c = first + 1; c < last; c++)
+            if (q.comp(q.cont[best], q.cont[c]))
+                best = c;
+        q.cont[hole] = std::move(q.cont[best]);
+        hole = best;
     }
+    sift_up(q, hole, top, std::move(elem));
 }
 
-template<typename T, typename C>
-void Priority_Queue<T, C>::make_heap(Priority_Queue<T, C> &q)
+template<typename T, typename C, size_t D>
+void Priority_Queue<T, C, D>::make_heap(Priority_Queue<T, C, D> &q)
 {
-    int start = q.cont.size() / 2 - 1;
-    for (int idx = start; idx >= 0; --idx)
-        heapify(q, idx);
+    if (q.size() < 2)
+        return;
+    int start = parent(q.cont.size() - 1);
+    for (int idx = start; idx >= ROOT; --idx) {
+        T elem = std::move(q.cont[idx]);
+        sift_down(q, idx, std::move(elem));
+    }
 }
 
 #endif /* Priority_Queue_hpp */
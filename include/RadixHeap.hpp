@@ -0,0 +1,177 @@
+#ifndef RadixHeap_hpp
+#define RadixHeap_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//
+// A Radix Heap is a monotone min-priority queue over unsigned integer keys:
+// every key pushed must be no smaller than the last key popped, which holds
+// for Dijkstra's algorithm with non-negative weights and for event
+// simulations. Entries are kept in B + 1 buckets for B-bit keys, an entry
+// with key k going to bucket 0 if k equals the last popped key and to the
+// bucket numbered by the highest bit in which they differ otherwise.
+//
+// When bucket 0 has run dry, the first non-empty bucket is emptied into the
+// lower buckets around its own minimum, the new last key; every entry only
+// ever moves down, so it moves at most B times in total. Buckets are plain
+// vectors, scanned and appended to sequentially, which makes the heap very
+// cache friendly compared to the pointer-chasing heaps.
+//
+// Keys may be any unsigned type up to 64 bits, std::uint32_t and
+// std::uint64_t in particular.
+//
+template<typename Key, typename Value>
+class RadixHeap {
+    static_assert(std::is_unsigned<Key>::value && sizeof(Key) <= 8,
+                  "radix heap keys must be unsigned integers of up to 64 bits");
+public:
+    //
+    // Inserts an entry. Its key must not be smaller than the last popped key.
+    //
+    // Time Complexity: O(1), plus the amortized O(B) moves per entry
+    //
+    void push(Key key, Value value);
+
+    //
+    // Removes the entry with the minimum key and returns its key and value.
+    // The heap must not be empty.
+    //
+    // Time Complexity: Amortized O(B)
+    //
+    std::pair<Key, Value> pop();
+
+    //
+    // The minimum entry, without removing it. Users should check for
+    // emptiness beforehand. Unless pop() would find it in bucket 0, the
+    // bucket holding it is scanned.
+    //
+    // Time Complexity: O(1) or O(size of a bucket)
+    //
+    Key top_key() const;
+    const Value& top_value() const;
+
+    bool empty() const;
+    size_t size() const;
+
+    void clear();  // also resets the last popped key to 0
+
+private:
+    static constexpr int BITS = 8 * sizeof(Key);
+
+    using Entry = std::pair<Key, Value>;
+
+    // last_ is the key last popped, so every key in the heap is at least
+    // last_ and bucket 0 holds those equal to it.
+    std::vector<Entry> buckets_[BITS + 1];
+    Key last_ {0};
+    size_t size_ {0};
+
+    int bucket(Key key) const;
+    const Entry& least() const;
+    void refill();
+};
+
+template<typename Key, typename Value>
+void RadixHeap<Key, Value>::push(Key key, Value value)
+{
+    buckets_[bucket(key)].emplace_back(key, std::move(value));
+    ++size_;
+}
+
+template<typename Key, typename Value>
+std::pair<Key, Value> RadixHeap<Key, Value>::pop()
+{
+    refill();
+    Entry entry = std::move(buckets_[0].back());
+    buckets_[0].pop_back();
+    --size_;
+    return entry;
+}
+
+template<typename Key, typename Value>
+Key RadixHeap<Key, Value>::top_key() const
+{
+    return least().first;
+}
+
+template<typename Key, typename Value>
+const Value& RadixHeap<Key, Value>::top_value() const
+{
+    return least().second;
+}
+
+template<typename Key, typename Value>
+bool RadixHeap<Key, Value>::empty() const
+{
+    return size_ == 0;
+}
+
+template<typename Key, typename Value>
+size_t RadixHeap<Key, Value>::size() const
+{
+    return size_;
+}
+
+template<typename Key, typename Value>
+void RadixHeap<Key, Value>::clear()
+{
+    for (std::vector<Entry> &b : buckets_)
+        b.clear();
+    last_ = 0;
+    size_ = 0;
+}
+
+template<typename Key, typename Value>
+int RadixHeap<Key, Value>::bucket(Key key) const
+{
+    const std::uint64_t diff = static_cast<std::uint64_t>(key ^ last_);
+    return diff == 0 ? 0 : 64 - __builtin_clzll(diff);
+}
+
+//
+// The minimum entry: the one pop() would return.
+//
+template<typename Key, typename Value>
+const typename RadixHeap<Key, Value>::Entry& RadixHeap<Key, Value>::least() const
+{
+    if (!buckets_[0].empty())
+        return buckets_[0].back();
+    int i = 1;
+    while (buckets_[i].empty())
+        ++i;
+    const Entry *min = &buckets_[i].front();
+    for (const Entry &entry : buckets_[i])
+        min = entry.first < min->first ? &entry : min;
+    return *min;
+}
+
+//
+// Makes bucket 0 non-empty, the heap being non-empty, by emptying the first
+// non-empty bucket around its minimum.
+//
+template<typename Key, typename Value>
+void RadixHeap<Key, Value>::refill()
+{
+    if (!buckets_[0].empty())
+        return;
+    int i = 1;
+    while (buckets_[i].empty())
+        ++i;
+    std::vector<Entry> &from = buckets_[i];
+    Key least = from.front().first;
+    for (const Entry &entry : from)
+        least = entry.first < least ? entry.first : least;
+    // The keys of bucket i agree with last_ above bit i - 1 and all differ
+    // from it in bit i - 1, so they agree with least from bit i - 1 up and
+    // land in lower buckets.
+    last_ = least;
+    for (Entry &entry : from)
+        buckets_[bucket(entry.first)].push_back(std::move(entry));
+    from.clear();
+}
+
+#endif  /* RadixHeap_hpp */
@@ -0,0 +1,389 @@
+#ifndef RankPairingHeap_hpp
+#define RankPairingHeap_hpp
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
+
+//
+// A Rank-Pairing Heap (Haeupler, Sen and Tarjan) matches the amortized
+// bounds of a Fibonacci heap with the simplicity of a pairing heap. The heap
+// is a circular list of half-trees: binary trees in which every left subtree
+// is heap ordered with respect to its parent, and whose root has no right
+// child. Linking two half-trees of equal rank makes the loser the left child
+// of the winner, the winner's former left subtree becoming the loser's right
+// subtree. The right pointers of the roots chain the root list itself.
+//
+// Ranks follow the type-2 rule: a node whose children have ranks a >= b
+// (-1 for a missing child) has rank a + 1 if a - b <= 1 and rank a
+// otherwise, while a root has rank one more than its left child. DECREASE-
+// KEY cuts the node loose as a new half-tree and restores the rule on the
+// path above it, which stops as soon as a rank does not change.
+//
+// The interface is the one of FibHeap: entries pair a Key with a Value,
+// Insert returns a Handle valid until the entry leaves the heap, and nodes
+// are recycled through a NodePool.
+//
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+class RankPairingHeap {
+    struct Node {
+        Key key;
+        Value value;
+        int rank {0};
+        Node *parent {nullptr};  // nullptr for roots
+        Node *left {nullptr};
+        Node *right {nullptr};   // the next root for roots
+
+        Node(Key &&_key, Value &&_value) : key{std::move(_key)}, value{std::move(_value)} {}
+    };
+
+public:
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool operator==(const Handle &h) const
+        {
+            return node_ == h.node_;
+        }
+        bool operator!=(const Handle &h) const
+        {
+            return node_ != h.node_;
+        }
+
+    private:
+        friend class RankPairingHeap;
+        explicit Handle(Node *node) : node_{node} {}
+        Node *node_ {nullptr};
+    };
+
+    explicit RankPairingHeap(const Compare &comp = Compare()) : comp_{comp} {}
+    RankPairingHeap(const RankPairingHeap&) = delete;
+    RankPairingHeap& operator=(const RankPairingHeap&) = delete;
+
+    //
+    // Adds a single-node half-tree to the root list.
+    //
+    // Time Complexity: O(1)
+    //
+    Handle Insert(Key key, Value value);
+
+    //
+    // Joins the two root lists; the handles into h remain valid. The unioned
+    // heap is left empty.
+    //
+    // Time Complexity: O(1), plus O(free nodes of h) to adopt them
+    //
+    void Union(RankPairingHeap&& h);
+
+    //
+    // Extracts the entry with the minimum key and returns its key and value.
+    // The right spine below the minimum falls apart into half-trees, and all
+    // half-trees are linked in a single pass by rank: a half-tree meeting
+    // another of the same rank is linked with it and set aside, not linked
+    // again, which suffices for the amortized bound.
+    //
+    // Time Complexity: Amortized O(lg n)
+    //
+    std::pair<Key, Value> ExtractMin();
+
+    //
+    // Decreases the key of an entry; keys that do not come before the
+    // current one are ignored.
+    //
+    // Time Complexity: Amortized O(1)
+    //
+    void DecreaseKey(Handle h, Key decreasedKey);
+
+    //
+    // Removes an entry from the heap, whatever its key.
+    //
+    // Time Complexity: Amortized O(lg n)
+    //
+    void Delete(Handle h);
+
+    ~RankPairingHeap();
+
+    // Accessors
+
+    int size() const;
+    bool empty() const;
+
+    // Users should check for emptiness beforehand.
+    const Key& minKey() const;
+    const Value& minValue() const;
+
+    const Key& key(Handle h) const;
+    Value& value(Handle h);
+    const Value& value(Handle h) const;
+
+private:
+    int size_ {0};
+    Node *min_ {nullptr};  // the root of minimum key, entry to the root list
+    Compare comp_;
+    NodePool<Node> pool_;
+
+    // ExtractMin() buckets the half-trees by rank here; entries are all
+    // nullptr between calls.
+    std::vector<Node*> rankTable_;
+
+    void AddRoot(Node *node);
+    void CutLoose(Node *node);
+    Node* Link(Node *a, Node *b);
+    Node* ExtractMinNode();
+};
+
+template<typename Key, typename Value, typename Compare>
+typename RankPairingHeap<Key, Value, Compare>::Handle
+RankPairingHeap<Key, Value, Compare>::Insert(Key key, Value value)
+{
+    Node *node = pool_.New(std::move(key), std::move(value));
+    AddRoot(node);
+    ++size_;
+    return Handle(node);
+}
+
+template<typename Key, typename Value, typename Compare>
+void RankPairingHeap<Key, Value, Compare>::Union(RankPairingHeap&& h)
+{
+    pool_.Merge(std::move(h.pool_));
+    if (h.min_ == nullptr)
+        return;
+    if (min_ == nullptr) {
+        min_ = h.min_;
+    } else {
+        // exchanging the successors of the two minima joins the circles
+        std::swap(min_->right, h.min_->right);
+        min_ = comp_(h.min_->key, min_->key) ? h.min_ : min_;
+    }
+    size_ += h.size_;
+
+    h.size_ = 0;
+    h.min_ = nullptr;
+}
+
+template<typename Key, typename Value, typename Compare>
+std::pair<Key, Value> RankPairingHeap<Key, Value, Compare>::ExtractMin()
+{
+    Node *z = ExtractMinNode();
+    std::pair<Key, Value> entry (std::move(z->key), std::move(z->value));
+    pool_.Delete(z);
+    return entry;
+}
+
+template<typename Key, typename Value, typename Compare>
+void RankPairingHeap<Key, Value, Compare>::DecreaseKey(Handle h, Key decreasedKey)
+{
+    Node *node = h.node_;
+    if (!comp_(decreasedKey, node->key))
+        return;
+    node->key = std::move(decreasedKey);
+    if (node->parent == nullptr) {
+        if (comp_(node->key, min_->key))
+            min_ = node;
+        return;
+    }
+    CutLoose(node);
+    AddRoot(node);
+}
+
+template<typename Key, typename Value, typename Compare>
+void RankPairingHeap<Key, Value, Compare>::Delete(Handle h)
+{
+    // As if decreased to minus infinity: cut loose, made the minimum, and
+    // extracted.
+    Node *node = h.node_;
+    if (node->parent != nullptr) {
+        CutLoose(node);
+        node->right = min_->right;
+        min_->right = node;
+    }
+    min_ = node;
+    pool_.Delete(ExtractMinNode());
+}
+
+template<typename Key, typename Value, typename Compare>
+RankPairingHeap<Key, Value, Compare>::~RankPairingHeap()
+{
+    if (std::is_trivially_destructible<Node>::value || min_ == nullptr)
+        return;  // pool_ releases the memory
+    // Once the root list is cut open after the minimum, every node is
+    // reached through left and right alone.
+    Node *first = min_->right;
+    min_->right = nullptr;
+    std::vector<Node*> todo {first};
+    while (!todo.empty()) {
+        Node *x = todo.back();
+        todo.pop_back();
+        if (x->left != nullptr)
+            todo.push_back(x->left);
+        if (x->right != nullptr)
+            todo.push_back(x->right);
+        pool_.Delete(x);
+    }
+}
+
+template<typename Key, typename Value, typename Compare>
+int RankPairingHeap<Key, Value, Compare>::size() const
+{
+    return size_;
+}
+
+template<typename Key, typename Value, typename Compare>
+bool RankPairingHeap<Key, Value, Compare>::empty() const
+{
+    return size_ == 0;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Key& RankPairingHeap<Key, Value, Compare>::minKey() const
+{
+    return min_->key;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Value& RankPairingHeap<Key, Value, Compare>::minValue() const
+{
+    return min_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Key& RankPairingHeap<Key, Value, Compare>::key(Handle h) const
+{
+    return h.node_->key;
+}
+
+template<typename Key, typename Value, typename Compare>
+Value& RankPairingHeap<Key, Value, Compare>::value(Handle h)
+{
+    return h.node_->value;
+}
+
+template<typename Key, typename Value, typename Compare>
+const Value& RankPairingHeap<Key, Value, Compare>::value(Handle h) const
+{
+    return h.node_->value;
+}
+
+//
+// Inserts a half-tree root right after the minimum, updating the minimum.
+//
+template<typename Key, typename Value, typename Compare>
+void RankPairingHeap<Key, Value, Compare>::AddRoot(Node *node)
+{
+    node->parent = nullptr;
+    if (min_ == nullptr) {
+        node->right = node;
+        min_ = node;
+        return;
+    }
+    node->right = min_->right;
+    min_->right = node;
+    if (comp_(node->key, min_->key))
+        min_ = node;
+}
+
+//
+// Detaches a non-root node with its left subtree, its right subtree taking
+// its place, turns it into a half-tree root and restores the rank rule on
+// the path above.
+//
+template<typename Key, typename Value, typename Compare>
+void RankPairingHeap<Key, Value, Compare>::CutLoose(Node *node)
+{
+    Node *parent = node->parent, *replacement = node->right;
+    (parent->left == node ? parent->left : parent->right) = replacement;
+    if (replacement != nullptr)
+        replacement->parent = parent;
+    node->parent = node->right = nullptr;
+    node->rank = node->left != nullptr ? node->left->rank + 1 : 0;
+
+    for (Node *u = parent; ; u = u->parent) {
+        if (u->parent == nullptr) {
+            u->rank = u->left != nullptr ? u->left->rank + 1 : 0;
+            break;
+        }
+        int a = u->left != nullptr ? u->left->rank : -1;
+        int b = u->right != nullptr ? u->right->rank : -1;
+        if (a < b)
+            std::swap(a, b);
+        const int rank = a - b <= 1 ? a + 1 : a;
+        if (rank >= u->rank)
+            break;
+        u->rank = rank;
+    }
+}
+
+//
+// Links two half-tree roots of equal rank, returning the winner.
+//
+template<typename Key, typename Value, typename Compare>
+typename RankPairingHeap<Key, Value, Compare>::Node*
+RankPairingHeap<Key, Value, Compare>::Link(Node *a, Node *b)
+{
+    if (comp_(b->key, a->key))
+        std::swap(a, b);
+    b->right = a->left;
+    if (b->right != nullptr)
+        b->right->parent = b;
+    b->parent = a;
+    a->left = b;
+    a->rank = b->rank + 1;
+    return a;
+}
+
+template<typename Key, typename Value, typename Compare>
+typename RankPairingHeap<Key, Value, Compare>::Node*
+RankPairingHeap<Key, Value, Compare>::ExtractMinNode()
+{
+    Node *z = min_;
+    --size_;
+
+    // Gather the other roots and the right spine below z, then link them.
+    std::size_t maxRank = 0;
+    Node *linked = nullptr;  // half-trees already linked, chained by right
+    auto add = [&](Node *x) {
+        x->parent = nullptr;
+        const std::size_t r = x->rank;
+        if (r >= rankTable_.size())
+            rankTable_.resize(2 * r + 2, nullptr);
+        if (rankTable_[r] == nullptr) {
+            rankTable_[r] = x;
+            maxRank = std::max(maxRank, r);
+            return;
+        }
+        Node *w = Link(rankTable_[r], x);
+        rankTable_[r] = nullptr;
+        w->right = linked;
+        linked = w;
+    };
+    for (Node *x = z->right, *next; x != z; x = next) {
+        next = x->right;
+        add(x);
+    }
+    for (Node *x = z->left, *next; x != nullptr; x = next) {
+        next = x->right;
+        x->right = nullptr;
+        x->rank = x->left != nullptr ? x->left->rank + 1 : 0;
+        add(x);
+    }
+
+    min_ = nullptr;
+    for (Node *x = linked, *next; x != nullptr; x = next) {
+        next = x->right;
+        AddRoot(x);
+    }
+    for (std::size_t r = 0; r <= maxRank && r < rankTable_.size(); r++) {
+        if (rankTable_[r] != nullptr) {
+            AddRoot(rankTable_[r]);
+            rankTable_[r] = nullptr;
+        }
+    }
+    return z;
+}
+
+#endif  /* RankPairingHeap_hpp */
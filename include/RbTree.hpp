@@ -2,85 +2,167 @@
 #define RbTree_hpp
 
 #include <functional>  // less
+#include <cstddef>
 #include <cstdint>  // uint8_t
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "EytzingerArray.hpp"
+#include "NodePool.hpp"
+#include "Parallel.hpp"
 
 enum struct Color : std::uint8_t {
     RED, BLACK
 };
 
-template<typename T>
+//
+// The nodes of a tree augmented by Augment carry an Augment::Data computed
+// from the node and its children, such as the size of their subtree; plain
+// nodes carry nothing extra.
+//
+template<typename T, typename Augment = void>
 struct RbNode {
     T key;
     Color color;
     RbNode *p;
     RbNode *left;
     RbNode *right;
+    typename Augment::Data aug;
+
+    static RbNode _NIL_NODE, *NIL;
+};
+
+template<typename T>
+struct RbNode<T, void> {
+    T key;
+    Color color;
+    RbNode *p;
+    RbNode *left;
+    RbNode *right;
 
     static RbNode _NIL_NODE, *NIL;
 };
 
-template<typename T, typename Compare = std::less<T>>
+//
+// Nodes handed to Insert(Node*) are allocated by the caller with new;
+// the tree deletes those still linked when it is destroyed. Alternatively
+// the tree allocates its nodes itself through the value-based Insert(T) and
+// Erase(T). With Pooled set, those nodes come from a NodePool instead of
+// new: they are packed into large slabs, erased ones are recycled, and
+// destroying or clearing a tree of trivially destructible keys just drops
+// the slabs rather than walking the tree. Pooled trees must not be given
+// nodes from new.
+//
+// An Augment policy keeps extra data in every node, derived from the node
+// and its two children by Augment::Update(Node*): the tree calls it on both
+// nodes of every rotation and along the path above every node it links in
+// or splices out, bottom-up, so each node's data is always up to date. Any
+// data that can be computed that way is maintained in O(lg n) per update
+// (CLRS 14.2); NIL keeps a value-initialized Data.
+//
+template<typename T, typename Compare = std::less<T>, bool Pooled = false,
+         typename Augment = void>
 class RbTree {
 public:
     using value_type = T;
+    using Node = RbNode<T, Augment>;
+
+    RbTree() = default;
+    RbTree(const RbTree&) = delete;
+    RbTree& operator=(const RbTree&) = delete;
     
-    void LeftRotate(RbNode<T> *x)
+
+    void LeftRotate(Node *x)
+    {
+        LeftRotate(this->root, x);
+    }
+
+    static void LeftRotate(Node *&root, Node *x)
     {
-        RbNode<T> *y = x->right;
+        Node *y = x->right;
         x->right = y->left;
-        if (y->left != RbNode<T>::NIL)
+        if (y->left != Node::NIL)
             y->left->p = x;
         y->p = x->p;
-        if (x->p == RbNode<T>::NIL)
-            this->root = y;
+        if (x->p == Node::NIL)
+            root = y;
         else if (x == x->p->left)
             x->p->left = y;
         else
             x->p->right = y;
         y->left = x;
         x->p = y;
+        Refresh(x);
+        Refresh(y);
     }
     
-    void RightRotate(RbNode<T> *x)
+    void RightRotate(Node *x)
     {
-        RbNode<T> *y = x->left;
+        RightRotate(this->root, x);
+    }
+
+    static void RightRotate(Node *&root, Node *x)
+    {
+        Node *y = x->left;
         x->left = y->right;
-        if (y->right != RbNode<T>::NIL)
+        if (y->right != Node::NIL)
             y->right->p = x;
         y->p = x->p;
-        if (x->p == RbNode<T>::NIL)
-            this->root = y;
+        if (x->p == Node::NIL)
+            root = y;
         else if (x == x->p->left)
             x->p->left = y;
         else
             x->p->right = y;
         y->right = x;
         x->p = y;
+        Refresh(x);
+        Refresh(y);
     }
 
-    void Insert(RbNode<T> *z)
+    void Insert(Node *z)
     {
-        RbNode<T> *y = RbNode<T>::NIL;
-        RbNode<T> *x = this->root;
-        while (x != RbNode<T>::NIL) {
+        Node *y = Node::NIL;
+        Node *x = this->root;
+        while (x != Node::NIL) {
             y = x;
             x = comp(z->key, x->key) ? x->left : x->right;
         }
         z->p = y;
-        if (y == RbNode<T>::NIL)
+        if (y == Node::NIL)
             this->root = z;
         else if (comp(z->key, y->key))
             y->left = z;
         else
             y->right = z;
-        z->left = z->right = RbNode<T>::NIL;
+        z->left = z->right = Node::NIL;
         z->color = Color::RED;
+        RefreshPath(z);
         InsertFixUp(z);
     }
     
-    void InsertFixUp(RbNode<T> *z)
+    //
+    // Inserts a new node holding key, even if key is already present, and
+    // returns it.
+    //
+    // Time Complexity: O(lg n)
+    //
+    Node* Insert(T key)
     {
-        RbNode<T> *y;
+        Node *z = NewNode(std::move(key));
+        Insert(z);
+        return z;
+    }
+    
+    void InsertFixUp(Node *z)
+    {
+        InsertFixUp(this->root, z);
+    }
+
+    static bool InsertFixUp(Node *&root, Node *z)
+    {
+        Node *y;
         while (z->p->color == Color::RED) {
             if (z->p == z->p->p->left) {
                 y = z->p->p->right;
@@ -92,11 +174,11 @@ public:
                 } else {
                     if (z == z->p->right) {
                         z = z->p;
-                        LeftRotate(z);
+                        LeftRotate(root, z);
                     }
                     z->p->color = Color::BLACK;
                     z->p->p->color = Color::RED;
-                    RightRotate(z->p->p);
+                    RightRotate(root, z->p->p);
                 }
             } else {
                 y = z->p->p->left;
@@ -108,20 +190,23 @@ public:
                 } else {
                     if (z == z->p->left) {
                         z = z->p;
-                        RightRotate(z);
+                        RightRotate(root, z);
                     }
                     z->p->color = Color::BLACK;
                     z->p->p->color = Color::RED;
-                    LeftRotate(z->p->p);
+                    LeftRotate(root, z->p->p);
                 }
             }
         }
-        this->root->color = Color::BLACK;
+        // a red root turning black adds a level to the black height
+        const bool taller = root->color == Color::RED;
+        root->color = Color::BLACK;
+        return taller;
     }
     
-    void Transplant(RbNode<T> *u, RbNode<T> *v)
+    void Transplant(Node *u, Node *v)
     {
-        if (u->p == RbNode<T>::NIL)
+        if (u->p == Node::NIL)
             this->root = v;
         else if (u == u->p->left)
             u->p->left = v;
@@ -130,15 +215,15 @@ public:
         v->p = u->p;
     }
     
-    void Delete(RbNode<T> *z)
+    void Delete(Node *z)
     {
-        RbNode<T> *x;
-        RbNode<T> *y = z;
+        Node *x;
+        Node *y = z;
         Color yOriginalColor = y->color;
-        if (z->left == RbNode<T>::NIL) {
+        if (z->left == Node::NIL) {
             x = z->right;
             Transplant(z, z->right);
-        } else if (z->right == RbNode<T>::NIL) {
+        } else if (z->right == Node::NIL) {
             x = z->left;
             Transplant(z, z->left);
         } else {
@@ -157,13 +242,40 @@ public:
             y->left->p = y;
             y->color = z->color;
         }
+        // x->p is the lowest node whose subtree lost a node
+        RefreshPath(x->p);
         if (yOriginalColor == Color::BLACK)
             DeleteFixUp(x);
     }
     
-    void DeleteFixUp(RbNode<T> *x)
+    //
+    // Unlinks a node the tree allocated itself and frees it.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void Erase(Node *z)
     {
-        RbNode<T> *w;
+        Delete(z);
+        FreeNode(z);
+    }
+
+    //
+    // Erases one node holding key, returning whether there was any.
+    //
+    // Time Complexity: O(lg n)
+    //
+    bool Erase(const T &key)
+    {
+        Node *z = Search(key);
+        if (z == Node::NIL)
+            return false;
+        Erase(z);
+        return true;
+    }
+    
+    void DeleteFixUp(Node *x)
+    {
+        Node *w;
         while (x != this->root && x->color == Color::BLACK) {
             if (x == x->p->left) {
                 w = x->p->right;
@@ -218,90 +330,553 @@ public:
         x->color = Color::BLACK;
     }
     
-    RbNode<T>* Search(T key, RbNode<T> *x)
+    Node* Search(T key, Node *x)
     {
-        while (x != RbNode<T>::NIL && x->key != key)
+        while (x != Node::NIL && x->key != key)
             x = comp(key, x->key) ? x->left : x->right;
         return x;
     }
 
-    RbNode<T>* Search(T key)
+    Node* Search(T key)
     {
         return Search(key, this->root);
     }
     
-    RbNode<T>* Minimum(RbNode<T> *x)
+    Node* Minimum(Node *x)
     {
-        while (x->left != RbNode<T>::NIL)
+        while (x->left != Node::NIL)
             x = x->left;
         return x;
     }
 
-    RbNode<T>* Minimum()
+    Node* Minimum()
     {
         return Minimum(this->root);
     }
     
-    RbNode<T>* Maximum(RbNode<T> *x)
+    Node* Maximum(Node *x)
     {
-        while (x->right != RbNode<T>::NIL)
+        while (x->right != Node::NIL)
             x = x->right;
         return x;
     }
 
-    RbNode<T>* Maximum()
+    Node* Maximum()
     {
         return Maximum(this->root);
     }
     
-    RbNode<T>* Successor(RbNode<T> *x)
+    Node* Successor(Node *x)
     {
-        if (x->right != RbNode<T>::NIL)
+        if (x->right != Node::NIL)
             return Minimum(x->right);
-        RbNode<T> *y = x->p;
-        while (y != RbNode<T>::NIL && x == y->right)
+        Node *y = x->p;
+        while (y != Node::NIL && x == y->right)
             x = y, y = y->p;
         return y;
     }
     
-    RbNode<T>* Predecessor(RbNode<T> *x)
+    Node* Predecessor(Node *x)
     {
-        if (x->left != RbNode<T>::NIL)
+        if (x->left != Node::NIL)
             return Maximum(x->left);
-        RbNode<T> *y = x->p;
-        while (y != RbNode<T>::NIL && x == y->left)
+        Node *y = x->p;
+        while (y != Node::NIL && x == y->left)
             x = y, y = y->p;
         return y;
     }
 
-    const RbNode<T>* Root() const
+    const Node* Root() const
     {
         return this->root;
     }
 
-    void Deallocate(RbNode<T> *x)
+    //
+    // Copies the keys into a static EytzingerArray, for faster searches in a
+    // read-only phase. Later updates to the tree do not reach the copy.
+    //
+    // Time Complexity: O(n)
+    //
+    EytzingerArray<T, Compare> Freeze() const
     {
-        if (x == RbNode<T>::NIL)
+        std::vector<const Node*> stack;
+        const Node *x = this->root;
+        return EytzingerArray<T, Compare>(Count(this->root), [&] {
+            for (; x != Node::NIL; x = x->left)
+                stack.push_back(x);
+            const Node *next = stack.back();
+            stack.pop_back();
+            x = next->right;
+            return next->key;
+        }, this->comp);
+    }
+
+    void Deallocate(Node *x)
+    {
+        if (x == Node::NIL)
             return;
         Deallocate(x->left);
         Deallocate(x->right);
-        delete x;
+        FreeNode(x);
+    }
+
+    //
+    // Frees all the nodes, leaving the tree empty.
+    //
+    // Time Complexity: O(n), or O(slabs) for pooled trivially destructible
+    // keys
+    //
+    void Clear()
+    {
+        if (DropsPool())
+            this->pool = NodePool<Node>();
+        else
+            Deallocate(this->root);
+        this->root = Node::NIL;
+    }
+
+    //
+    // Replaces the contents of the tree with the keys in [first, last), which
+    // must be sorted under Compare and free of duplicates. The nodes are
+    // linked into a balanced tree directly, all black but for the partial
+    // bottom level, without any search or fix-up.
+    //
+    // Time Complexity: O(n)
+    //
+    template<typename InputIterator>
+    void Build(InputIterator first, InputIterator last)
+    {
+        Clear();
+        std::vector<Node*> nodes;
+        for (; first != last; ++first)
+            nodes.push_back(NewNode(T(*first)));
+        int complete = 0;  // levels filled completely
+        while ((std::size_t(2) << complete) <= nodes.size() + 1)
+            complete++;
+        this->root = Build(nodes.data(), nodes.size(), 0, complete, Node::NIL);
+    }
+
+    //
+    // Appends key and then the keys of greater to the tree, leaving greater
+    // empty. Every key of the tree must be ordered before key, and key
+    // before every key of greater.
+    //
+    // Time Complexity: O(lg n)
+    //
+    void Join(T key, RbTree &&greater)
+    {
+        if constexpr (Pooled)
+            this->pool.Merge(std::move(greater.pool));
+        this->root = Join(Whole(this->root), NewNode(std::move(key)), Whole(greater.root)).root;
+        greater.root = Node::NIL;
+    }
+
+    //
+    // Moves the keys ordered after key to greater, replacing its contents,
+    // and keeps those ordered before it. Returns whether key itself was
+    // present; its node is freed. Nodes cannot move between pools, so only
+    // unpooled trees split.
+    //
+    // Time Complexity: O(lg n)
+    //
+    bool Split(const T &key, RbTree &greater)
+    {
+        static_assert(!Pooled, "a pooled tree cannot hand its nodes to another tree");
+        greater.Clear();
+        Subtree l, r;
+        Node *m;
+        Split(Whole(this->root), key, l, m, r);
+        this->root = l.root;
+        greater.root = r.root;
+        Blacken(this->root);
+        Blacken(greater.root);
+        if (m == Node::NIL)
+            return false;
+        FreeNode(m);
+        return true;
+    }
+
+    //
+    // Bulk set operations, treating both trees as sets: the tree becomes its
+    // union, intersection or difference with t, which is left empty. They
+    // follow the join-based divide and conquer of Blelloch, Ferizovic and
+    // Sun: t's root splits this tree, the two halves are combined with t's
+    // subtrees recursively and the results joined back. The recursive calls
+    // are independent, so the top ones run on up to numThreads threads
+    // (non-positive values select the hardware threads).
+    //
+    // Time Complexity: O(m lg(n/m + 1)) work for m keys in t, so t should be
+    // the smaller tree, and O(lg^2 n) span
+    //
+    void Union(RbTree &&t, int numThreads = 0)
+    {
+        Combine(std::move(t), numThreads, [this](Subtree a, Subtree b, int spawn, std::vector<Node*> &garbage) {
+            return Union(a, b, spawn, garbage);
+        });
+    }
+
+    void Intersection(RbTree &&t, int numThreads = 0)
+    {
+        Combine(std::move(t), numThreads, [this](Subtree a, Subtree b, int spawn, std::vector<Node*> &garbage) {
+            return Intersection(a, b, spawn, garbage);
+        });
+    }
+
+    void Difference(RbTree &&t, int numThreads = 0)
+    {
+        Combine(std::move(t), numThreads, [this](Subtree a, Subtree b, int spawn, std::vector<Node*> &garbage) {
+            return Difference(a, b, spawn, garbage);
+        });
     }
 
     ~RbTree()
     {
-        Deallocate(this->root);
+        if (!DropsPool())
+            Deallocate(this->root);
     }
     
-private:
-    RbNode<T> *root {RbNode<T>::NIL};
+protected:
+    Node *root {Node::NIL};
     Compare comp{};
+
+private:
+    NodePool<Node> pool;  // used only when Pooled
+
+    // whether the pool can be released without visiting the nodes
+    static constexpr bool DropsPool()
+    {
+        return Pooled && std::is_trivially_destructible<T>::value;
+    }
+
+    // A red leaf holding key, with every field set.
+    static Node Leaf(T &&key)
+    {
+        if constexpr (std::is_void<Augment>::value)
+            return Node{std::move(key), Color::RED, Node::NIL, Node::NIL, Node::NIL};
+        else
+            return Node{std::move(key), Color::RED, Node::NIL, Node::NIL, Node::NIL, {}};
+    }
+
+    Node* NewNode(T &&key)
+    {
+        if constexpr (Pooled)
+            return this->pool.New(Leaf(std::move(key)));
+        else
+            return new Node(Leaf(std::move(key)));
+    }
+
+    void FreeNode(Node *x)
+    {
+        if constexpr (Pooled)
+            this->pool.Delete(x);
+        else
+            delete x;
+    }
+
+    static void Refresh(Node *x)
+    {
+        if constexpr (!std::is_void<Augment>::value)
+            Augment::Update(x);
+    }
+
+    static void RefreshPath(Node *x)
+    {
+        if constexpr (!std::is_void<Augment>::value)
+            for (; x != Node::NIL; x = x->p)
+                Augment::Update(x);
+    }
+
+    // Subtrees below this black height are combined on the calling thread.
+    static constexpr int PARALLEL_BLACK_HEIGHT = 8;
+
+    //
+    // A detached subtree along with its black height, which the bulk
+    // operations carry down and back up rather than walk a spine for.
+    //
+    struct Subtree {
+        Node *root;
+        int height;
+    };
+
+    static Node* Detach(Node *x)
+    {
+        if (x != Node::NIL)
+            x->p = Node::NIL;
+        return x;
+    }
+
+    static std::size_t Count(const Node *x)
+    {
+        return x == Node::NIL ? 0 : Count(x->left) + 1 + Count(x->right);
+    }
+
+    // Makes the root of a detached subtree a valid tree's.
+    static void Blacken(Node *x)
+    {
+        if (x != Node::NIL)
+            x->color = Color::BLACK;
+    }
+
+    // Black nodes on the path from x down to a leaf, x included.
+    static int BlackHeight(const Node *x)
+    {
+        int h = 0;
+        for (; x != Node::NIL; x = x->left)
+            h += x->color == Color::BLACK;
+        return h;
+    }
+
+    static Subtree Whole(Node *root)
+    {
+        return Subtree{Detach(root), BlackHeight(root)};
+    }
+
+    static void Blacken(Subtree &s)
+    {
+        if (s.root != Node::NIL && s.root->color == Color::RED) {
+            s.root->color = Color::BLACK;
+            s.height++;
+        }
+    }
+
+    // The detached left and right subtrees of the nonempty s.
+    static Subtree Left(const Subtree &s)
+    {
+        return Subtree{Detach(s.root->left), s.height - (s.root->color == Color::BLACK)};
+    }
+
+    static Subtree Right(const Subtree &s)
+    {
+        return Subtree{Detach(s.root->right), s.height - (s.root->color == Color::BLACK)};
+    }
+
+    //
+    // Links nodes[0, n) into a balanced subtree at the given depth, coloring
+    // red the nodes below the complete levels.
+    //
+    static Node* Build(Node **nodes, std::size_t n, int depth, int complete, Node *parent)
+    {
+        if (n == 0)
+            return Node::NIL;
+        Node *x = nodes[n / 2];
+        x->p = parent;
+        x->color = depth < complete ? Color::BLACK : Color::RED;
+        x->left = Build(nodes, n / 2, depth + 1, complete, x);
+        x->right = Build(nodes + n / 2 + 1, n - n / 2 - 1, depth + 1, complete, x);
+        Refresh(x);
+        return x;
+    }
+
+    //
+    // Joins the subtrees l and r with the node k between them. The shorter
+    // subtree and k replace the first black node of matching black height
+    // down the facing spine of the taller one, as a red node, and the
+    // insertion fix-up repairs any red parent, adding a black level only
+    // when it pushes the red up to the root.
+    //
+    // Time Complexity: O(|hl - hr| + 1)
+    //
+    static Subtree Join(Subtree l, Node *k, Subtree r)
+    {
+        for (Subtree *s : {&l, &r})
+            Blacken(*s);
+        k->left = l.root;
+        k->right = r.root;
+        k->p = Node::NIL;
+        if (l.height == r.height) {
+            k->color = Color::BLACK;
+            for (Node *x : {l.root, r.root})
+                if (x != Node::NIL)
+                    x->p = k;
+            Refresh(k);
+            return Subtree{k, l.height + 1};
+        }
+        const bool right = l.height > r.height;  // descend the right spine of l
+        const Subtree &taller = right ? l : r, &shorter = right ? r : l;
+        Node *root = taller.root;
+        Node *parent = Node::NIL, *c = root;
+        for (int h = taller.height; c->color == Color::RED || h > shorter.height;
+             c = right ? c->right : c->left) {
+            h -= c->color == Color::BLACK;
+            parent = c;
+        }
+        (right ? k->left : k->right) = c;
+        (right ? parent->right : parent->left) = k;
+        k->p = parent;
+        k->color = Color::RED;
+        for (Node *x : {c, shorter.root})
+            if (x != Node::NIL)
+                x->p = k;
+        RefreshPath(k);
+        const bool grew = InsertFixUp(root, k);
+        return Subtree{root, taller.height + grew};
+    }
+
+    //
+    // Splits t into the keys before key, the node holding key (or NIL) and
+    // the keys after it. The joins on the way back up each cost the
+    // difference of two heights that grow along the path, so they add up to
+    // O(lg n).
+    //
+    void Split(Subtree t, const T &key, Subtree &l, Node *&m, Subtree &r) const
+    {
+        if (t.root == Node::NIL) {
+            l = r = Subtree{Node::NIL, 0};
+            m = Node::NIL;
+            return;
+        }
+        const Subtree a = Left(t), b = Right(t);
+        if (comp(key, t.root->key)) {
+            Split(a, key, l, m, r);
+            r = Join(r, t.root, b);
+        } else if (comp(t.root->key, key)) {
+            Split(b, key, l, m, r);
+            l = Join(a, t.root, l);
+        } else {
+            l = a;
+            m = t.root;
+            r = b;
+        }
+    }
+
+    // Detaches the last node of the nonempty subtree t and returns the rest.
+    static Subtree SplitLast(Subtree t, Node *&last)
+    {
+        const Subtree a = Left(t), b = Right(t);
+        if (b.root == Node::NIL) {
+            last = t.root;
+            return a;
+        }
+        return Join(a, t.root, SplitLast(b, last));
+    }
+
+    // Joins the subtrees l and r, all of whose keys follow those of l.
+    static Subtree Join(Subtree l, Subtree r)
+    {
+        if (l.root == Node::NIL)
+            return r;
+        Node *last;
+        l = SplitLast(l, last);
+        return Join(l, last, r);
+    }
+
+    static void Collect(Node *x, std::vector<Node*> &garbage)
+    {
+        if (x == Node::NIL)
+            return;
+        garbage.push_back(x);
+        Collect(x->left, garbage);
+        Collect(x->right, garbage);
+    }
+
+    //
+    // Runs left and right, handing each the list collecting the nodes to
+    // free. While spawn is positive left runs on a new thread with its own
+    // list, as the pool must only be touched from one thread.
+    //
+    template<typename F, typename G>
+    static void Fork(int spawn, std::vector<Node*> &garbage, F left, G right)
+    {
+        if (spawn <= 0) {
+            left(garbage);
+            right(garbage);
+            return;
+        }
+        std::vector<Node*> collected;
+        std::thread thread([&] { left(collected); });
+        right(garbage);
+        thread.join();
+        garbage.insert(garbage.end(), collected.begin(), collected.end());
+    }
+
+    template<typename F>
+    void Combine(RbTree &&t, int numThreads, F combine)
+    {
+        if constexpr (Pooled)
+            this->pool.Merge(std::move(t.pool));
+        int spawn = 0;  // levels of recursion that fork
+        for (const int threads = ResolveThreads(numThreads); (1 << spawn) < threads; )
+            spawn++;
+        std::vector<Node*> garbage;
+        this->root = combine(Whole(this->root), Whole(t.root), spawn, garbage).root;
+        Blacken(this->root);
+        t.root = Node::NIL;
+        for (Node *x : garbage)
+            FreeNode(x);
+    }
+
+    Subtree Union(Subtree a, Subtree b, int spawn, std::vector<Node*> &garbage) const
+    {
+        if (a.root == Node::NIL)
+            return b;
+        if (b.root == Node::NIL)
+            return a;
+        if (b.height < PARALLEL_BLACK_HEIGHT)
+            spawn = 0;
+        const Subtree bl = Left(b), br = Right(b);
+        Subtree l, r;
+        Node *m;
+        Split(a, b.root->key, l, m, r);
+        if (m != Node::NIL)
+            garbage.push_back(m);
+        Fork(spawn, garbage,
+             [&](std::vector<Node*> &g) { l = Union(l, bl, spawn - 1, g); },
+             [&](std::vector<Node*> &g) { r = Union(r, br, spawn - 1, g); });
+        return Join(l, b.root, r);
+    }
+
+    Subtree Intersection(Subtree a, Subtree b, int spawn, std::vector<Node*> &garbage) const
+    {
+        if (a.root == Node::NIL || b.root == Node::NIL) {
+            Collect(a.root, garbage);
+            Collect(b.root, garbage);
+            return Subtree{Node::NIL, 0};
+        }
+        if (b.height < PARALLEL_BLACK_HEIGHT)
+            spawn = 0;
+        const Subtree bl = Left(b), br = Right(b);
+        Subtree l, r;
+        Node *m;
+        Split(a, b.root->key, l, m, r);
+        garbage.push_back(b.root);
+        Fork(spawn, garbage,
+             [&](std::vector<Node*> &g) { l = Intersection(l, bl, spawn - 1, g); },
+             [&](std::vector<Node*> &g) { r = Intersection(r, br, spawn - 1, g); });
+        return m != Node::NIL ? Join(l, m, r) : Join(l, r);
+    }
+
+    Subtree Difference(Subtree a, Subtree b, int spawn, std::vector<Node*> &garbage) const
+    {
+        if (a.root == Node::NIL || b.root == Node::NIL) {
+            Collect(b.root, garbage);
+            return a;
+        }
+        if (b.height < PARALLEL_BLACK_HEIGHT)
+            spawn = 0;
+        const Subtree bl = Left(b), br = Right(b);
+        Subtree l, r;
+        Node *m;
+        Split(a, b.root->key, l, m, r);
+        garbage.push_back(b.root);
+        if (m != Node::NIL)
+            garbage.push_back(m);
+        Fork(spawn, garbage,
+             [&](std::vector<Node*> &g) { l = Difference(l, bl, spawn - 1, g); },
+             [&](std::vector<Node*> &g) { r = Difference(r, br, spawn - 1, g); });
+        return Join(l, r);
+    }
 };
 
+template<typename T, typename Augment>
+RbNode<T, Augment> RbNode<T, Augment>::_NIL_NODE = RbNode{T{}, Color::BLACK};
+
+template<typename T, typename Augment>
+RbNode<T, Augment> *RbNode<T, Augment>::NIL = &_NIL_NODE;
+
 template<typename T>
-RbNode<T> RbNode<T>::_NIL_NODE = RbNode{T{}, Color::BLACK};
+RbNode<T, void> RbNode<T, void>::_NIL_NODE = RbNode{T{}, Color::BLACK};
 
 template<typename T>
-RbNode<T> *RbNode<T>::NIL = &_NIL_NODE;
+RbNode<T, void> *RbNode<T, void>::NIL = &_NIL_NODE;
 
 #endif  // RbTree_hpp
@@ -0,0 +1,53 @@
+#ifndef SetIntersection_hpp
+#define SetIntersection_hpp
+
+#include <cstddef>
+
+//
+// Intersection kernels for sorted, duplicate-free arrays of integers, such
+// as the sorted neighbor lists of a graph.
+//
+// Every kernel writes the common elements of a[0..na) and b[0..nb) to `out`
+// in ascending order and returns how many there are. `out` must have room
+// for min(na, nb) elements; passing a null `out` only counts the common
+// elements, which is what triangle counting needs.
+//
+
+//
+// Classic two-pointer merge. Best when both inputs have similar sizes and
+// no vector instructions are available.
+//
+// Time Complexity: O(na + nb)
+//
+std::size_t IntersectMerge(const int *a, std::size_t na, const int *b,
+                           std::size_t nb, int *out = nullptr);
+
+//
+// Looks up every element of the smaller array in the larger one with an
+// exponential (galloping) search that resumes where the previous one
+// stopped. Wins by a wide margin when the sizes are heavily skewed.
+//
+// Time Complexity: O(min(na, nb) * lg(max(na, nb)))
+//
+std::size_t IntersectGalloping(const int *a, std::size_t na, const int *b,
+                               std::size_t nb, int *out = nullptr);
+
+//
+// Shuffle-based vector kernel: compares a block of a against every rotation
+// of a block of b, then compacts the matches with a shuffle table. Uses
+// 8-lane AVX2 when compiled with it, 4-lane SSE otherwise, and falls back
+// to IntersectMerge on targets with neither.
+//
+// Time Complexity: O(na + nb)
+//
+std::size_t IntersectSIMD(const int *a, std::size_t na, const int *b,
+                          std::size_t nb, int *out = nullptr);
+
+//
+// Picks the appropriate kernel for the input sizes: galloping when one array
+// is much larger than the other, the vector kernel otherwise.
+//
+std::size_t Intersect(const int *a, std::size_t na, const int *b,
+                      std::size_t nb, int *out = nullptr);
+
+#endif  /* SetIntersection_hpp */
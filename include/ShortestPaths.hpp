@@ -0,0 +1,131 @@
+#ifndef ShortestPaths_hpp
+#define ShortestPaths_hpp
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Parallel.hpp"
+#include "Priority_Queue.hpp"
+
+//
+// Shortest path algorithms. Distances are ints, INF_DIST marks unreachable
+// vertices, and all path lengths (including the most negative prefix of any
+// path) are assumed to stay within (-INF_DIST / 2, INF_DIST / 2). The graph
+// algorithms accept any type G providing V() and Neighbors(v), as described
+// in GraphAlgorithms.hpp.
+//
+
+constexpr int INF_DIST {1000000007};
+
+//
+// Computes all-pairs shortest paths in place on a row-major n x n matrix,
+// where dist[i * n + j] holds the weight of the edge i -> j (INF_DIST if
+// there is none) and the diagonal holds zeros. Returns false, leaving the
+// matrix in an unspecified state, if the graph has a negative cycle.
+//
+// The matrix is processed in 64 x 64 tiles. For every diagonal tile k, the
+// tile itself is relaxed first, then all tiles of row k and column k in
+// parallel, then all remaining tiles in parallel; every tile update is a
+// min-plus product whose inner loop runs on AVX2 (or SSE4.1) registers.
+// Three tiles fit in the L1/L2 caches, so the O(n^3) work streams from cache
+// rather than memory.
+//
+// Time Complexity: O(n^3), spread over `numThreads` threads
+//
+bool FloydWarshall(std::vector<int> &dist, int n, int numThreads = 0);
+
+//
+// Single-source shortest paths for non-negative edge weights, or for any
+// weights once a feasible potential h is given (h[v] <= h[u] + w(u, v) for
+// every edge): edges are then relaxed with the reduced weight
+// w(u, v) + h[u] - h[v] >= 0 and the returned distances are the reduced ones.
+//
+// Time Complexity: O(E lg E)
+//
+template<typename G>
+std::vector<int> Dijkstra(const G &g, int src, const std::vector<int> *h = nullptr)
+{
+    using Entry = std::pair<int, int>;  // (distance, vertex)
+    std::vector<int> dist (g.V(), INF_DIST);
+    std::vector<bool> done (g.V(), false);
+    Priority_Queue<Entry, std::greater<Entry>, 4> q;  // 4-ary: fewer levels to sift through
+    dist[src] = 0;
+    q.enqueue({0, src});
+    while (!q.empty()) {
+        int u = q.dequeue().second;
+        if (done[u]) continue;  // stale entry, there is no decrease-key
+        done[u] = true;
+        for (std::pair<int, int> edge : g.Neighbors(u)) {
+            int v = edge.first;
+            int w = h ? edge.second + (*h)[u] - (*h)[v] : edge.second;
+            if (!done[v] && dist[u] + w < dist[v]) {
+                dist[v] = dist[u] + w;
+                q.enqueue({dist[v], v});
+            }
+        }
+    }
+    return dist;
+}
+
+//
+// Bellman-Ford from a virtual source joined to every vertex by a zero-weight
+// edge. On success, h holds a feasible potential for Dijkstra; returns false
+// if the graph has a negative cycle.
+//
+// Time Complexity: O(VE)
+//
+template<typename G>
+bool BellmanFord(const G &g, std::vector<int> &h)
+{
+    const int V = g.V();
+    h.assign(V, 0);
+    for (int round = 0; round <= V; round++) {
+        bool relaxed = false;
+        for (int u = 0; u < V; u++) {
+            for (std::pair<int, int> edge : g.Neighbors(u)) {
+                if (h[u] + edge.second < h[edge.first]) {
+                    h[edge.first] = h[u] + edge.second;
+                    relaxed = true;
+                }
+            }
+        }
+        if (!relaxed)
+            return true;
+    }
+    return false;  // still relaxing after V rounds
+}
+
+//
+// Johnson's algorithm: reweights the edges with Bellman-Ford potentials (only
+// if some weight is negative) and runs Dijkstra from every vertex, the
+// sources being distributed among `numThreads` threads. Fills `dist` like
+// FloydWarshall and returns false if the graph has a negative cycle.
+//
+// Time Complexity: O(VE lg E), which beats O(V^3) on sparse graphs
+//
+template<typename G>
+bool Johnson(const G &g, std::vector<int> &dist, int numThreads = 0)
+{
+    const int V = g.V();
+    bool negative = false;
+    for (int u = 0; u < V && !negative; u++)
+        for (std::pair<int, int> edge : g.Neighbors(u))
+            negative = negative || edge.second < 0;
+    std::vector<int> h;
+    if (negative && !BellmanFord(g, h))
+        return false;
+
+    dist.assign(static_cast<std::size_t>(V) * V, INF_DIST);
+    ParallelFor(V, numThreads, 1, [&](int, std::size_t first, std::size_t last) {
+        for (std::size_t u = first; u < last; u++) {
+            std::vector<int> row (Dijkstra(g, u, negative ? &h : nullptr));
+            for (int v = 0; v < V; v++)
+                if (row[v] != INF_DIST)
+                    dist[u * V + v] = negative ? row[v] - h[u] + h[v] : row[v];
+        }
+    });
+    return true;
+}
+
+#endif  /* ShortestPaths_hpp */
@@ -10,6 +10,7 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <stdexcept>
 #include <exception>
 
 template<typename T>
@@ -135,7 +136,7 @@ void Stack<T>::Extend()
     T* nbuf = new T[bufsz * 2];
     std::copy(buf, buf + bufsz, nbuf);
     bufsz *= 2;
-    delete buf;
+    delete[] buf;
     buf = nbuf;
 }
 
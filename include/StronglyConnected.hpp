@@ -0,0 +1,291 @@
+#ifndef StronglyConnected_hpp
+#define StronglyConnected_hpp
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Parallel.hpp"
+#include "Stack.hpp"
+
+//
+// Strongly connected components of a directed graph G providing V() and
+// Neighbors(v) (see GraphAlgorithms.hpp). Both algorithms return the
+// component id of every vertex, ids being numbered from 0 without gaps.
+// On undirected graphs they yield the connected components.
+//
+
+//
+// Tarjan's algorithm with the recursion unrolled onto explicit Stacks, so
+// arbitrarily deep graphs (long paths, for instance) cannot overflow the
+// call stack. Components are numbered in reverse topological order of the
+// condensation: every edge between components leads to a smaller id.
+//
+// Time Complexity: O(V + E)
+//
+template<typename G>
+std::vector<int> TarjanSCC(const G &g)
+{
+    using Iter = decltype(g.Neighbors(0).begin());
+    struct Frame {
+        int v;
+        Iter next, end;  // edges of v still to be explored
+    };
+
+    const int V = g.V();
+    std::vector<int> index (V, -1), low (V, 0), comp (V, -1);
+    std::vector<bool> onStack (V, false);
+    Stack<int> visited;   // vertices whose component is not yet known
+    Stack<Frame> calls;   // the would-be recursion stack
+    int counter = 0, components = 0;
+
+    auto visit = [&](int v) {
+        index[v] = low[v] = counter++;
+        visited.Push(v);
+        onStack[v] = true;
+        auto &&range = g.Neighbors(v);  // a reference into g for Graph
+        calls.Push(Frame{v, range.begin(), range.end()});
+    };
+
+    for (int s = 0; s < V; s++) {
+        if (index[s] != -1)
+            continue;
+        visit(s);
+        while (!calls.IsEmpty()) {
+            Frame &f = calls.Top();
+            if (f.next != f.end) {
+                const int v = f.v, w = (*f.next).first;
+                ++f.next;
+                if (index[w] == -1)
+                    visit(w);  // invalidates f
+                else if (onStack[w])
+                    low[v] = std::min(low[v], index[w]);
+                continue;
+            }
+            const int v = f.v;
+            calls.Pop();
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = visited.Pop();
+                    onStack[w] = false;
+                    comp[w] = components;
+                } while (w != v);
+                ++components;
+            }
+            if (!calls.IsEmpty()) {
+                const int parent = calls.Top().v;
+                low[parent] = std::min(low[parent], low[v]);
+            }
+        }
+    }
+    return comp;
+}
+
+//
+// Parallel forward-backward (FW-BW) decomposition with trimming.
+//
+// Trimming first peels off, in parallel rounds, every vertex without an
+// incoming or outgoing edge among the remaining ones; each such vertex is a
+// component of its own, and they make up a large share of real graphs.
+// What remains is split recursively: the vertices both reachable from a
+// pivot (forward) and reaching it (backward) form the pivot's component,
+// and forward-only, backward-only and unreached vertices become three
+// independent subproblems, since no component can span two of them.
+//
+// Large subproblems are handled one at a time with level-synchronous BFS
+// spread across all threads; this quickly carves out the giant component
+// typical of real graphs. The many small subproblems left afterwards are
+// then distributed among the threads, each solved with sequential BFS.
+//
+// Time Complexity: O((V + E) lg V) expected work
+//
+template<typename G>
+std::vector<int> ForwardBackwardSCC(const G &g, int numThreads = 0)
+{
+    const int V = g.V();
+    const int T = ResolveThreads(numThreads);
+    const std::size_t PARALLEL_MIN {1 << 12};  // smallest subproblem with parallel BFS
+    enum : std::uint8_t { FW = 1, BW = 2 };
+
+    // Reverse adjacency for the backward searches, in CSR form.
+    std::vector<std::size_t> rstart (V + 1, 0);
+    for (int u = 0; u < V; u++)
+        for (std::pair<int, int> edge : g.Neighbors(u))
+            ++rstart[edge.first + 1];
+    for (int v = 0; v < V; v++)
+        rstart[v + 1] += rstart[v];
+    std::vector<int> radj (rstart[V]);
+    {
+        std::vector<std::size_t> next (rstart.begin(), rstart.end() - 1);
+        for (int u = 0; u < V; u++)
+            for (std::pair<int, int> edge : g.Neighbors(u))
+                radj[next[edge.first]++] = u;
+    }
+
+    // part[v] names the subproblem holding v (ids are never reused, so a
+    // stale read can never match), comp[v] is -1 until v is assigned.
+    std::vector<std::atomic<int>> comp (V), part (V);
+    std::vector<std::atomic<std::uint8_t>> mark (V);
+    for (int v = 0; v < V; v++) {
+        comp[v].store(-1, std::memory_order_relaxed);
+        part[v].store(0, std::memory_order_relaxed);
+        mark[v].store(0, std::memory_order_relaxed);
+    }
+    std::atomic<int> nextComp {0}, nextPart {1};
+
+    auto live = [&](int w, int p) {
+        return part[w].load(std::memory_order_relaxed) == p &&
+            comp[w].load(std::memory_order_relaxed) == -1;
+    };
+    // Calls fn(w) for the live neighbors of v in subproblem p, following
+    // edges forwards or backwards.
+    auto forEachNeighbor = [&](int v, int p, bool forward, auto fn) {
+        if (forward) {
+            for (std::pair<int, int> edge : g.Neighbors(v))
+                if (live(edge.first, p))
+                    fn(edge.first);
+        } else {
+            for (std::size_t e = rstart[v]; e < rstart[v + 1]; e++)
+                if (live(radj[e], p))
+                    fn(radj[e]);
+        }
+    };
+
+    // Trimming, repeated until a round peels off less than 1% of the graph.
+    for (;;) {
+        std::atomic<std::size_t> trimmed {0};
+        ParallelFor(V, T, 1024, [&](int, std::size_t first, std::size_t last) {
+            std::size_t local = 0;
+            for (std::size_t v = first; v < last; v++) {
+                if (comp[v].load(std::memory_order_relaxed) != -1)
+                    continue;
+                bool in = false, out = false;
+                forEachNeighbor(v, 0, true, [&](int w) { out = out || w != static_cast<int>(v); });
+                forEachNeighbor(v, 0, false, [&](int w) { in = in || w != static_cast<int>(v); });
+                if (!in || !out) {
+                    comp[v].store(nextComp.fetch_add(1, std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+                    ++local;
+                }
+            }
+            trimmed += local;
+        });
+        if (trimmed * 100 < static_cast<std::size_t>(V) + 1)
+            break;
+    }
+
+    struct Task {
+        int part;
+        std::vector<int> verts;
+    };
+
+    // Splits a subproblem around its pivot, using `search` to mark the
+    // forward and backward closures, and appends the non-empty remainders
+    // to `out`.
+    auto split = [&](Task &task, auto search, std::vector<Task> &out) {
+        const int p = task.part;
+        // a vertex of high in-degree likely sits in a big component
+        int pivot = task.verts[0];
+        for (int v : task.verts)
+            if (rstart[v + 1] - rstart[v] > rstart[pivot + 1] - rstart[pivot])
+                pivot = v;
+        search(pivot, p, true);
+        search(pivot, p, false);
+        const int c = nextComp.fetch_add(1, std::memory_order_relaxed);
+        Task sub[3] = {{nextPart++, {}}, {nextPart++, {}}, {nextPart++, {}}};
+        for (int v : task.verts) {
+            const std::uint8_t m = mark[v].exchange(0, std::memory_order_relaxed);
+            if (m == (FW | BW)) {
+                comp[v].store(c, std::memory_order_relaxed);
+            } else {
+                Task &t = sub[m];  // 0: unreached, FW: forward only, BW: backward only
+                part[v].store(t.part, std::memory_order_relaxed);
+                t.verts.push_back(v);
+            }
+        }
+        for (Task &t : sub)
+            if (!t.verts.empty())
+                out.push_back(std::move(t));
+    };
+
+    auto sequentialSearch = [&](int src, int p, bool forward) {
+        const std::uint8_t bit = forward ? FW : BW;
+        std::vector<int> todo {src};
+        mark[src].fetch_or(bit, std::memory_order_relaxed);
+        while (!todo.empty()) {
+            int v = todo.back();
+            todo.pop_back();
+            forEachNeighbor(v, p, forward, [&](int w) {
+                if (!(mark[w].fetch_or(bit, std::memory_order_relaxed) & bit))
+                    todo.push_back(w);
+            });
+        }
+    };
+
+    auto parallelSearch = [&](int src, int p, bool forward) {
+        const std::uint8_t bit = forward ? FW : BW;
+        std::vector<int> frontier {src};
+        std::vector<std::vector<int>> found (T);
+        mark[src].fetch_or(bit, std::memory_order_relaxed);
+        while (!frontier.empty()) {
+            ParallelFor(frontier.size(), T, 256, [&](int tid, std::size_t first, std::size_t last) {
+                for (std::size_t i = first; i < last; i++)
+                    forEachNeighbor(frontier[i], p, forward, [&](int w) {
+                        if (!(mark[w].fetch_or(bit, std::memory_order_relaxed) & bit))
+                            found[tid].push_back(w);
+                    });
+            });
+            frontier.clear();
+            for (std::vector<int> &f : found) {
+                frontier.insert(frontier.end(), f.begin(), f.end());
+                f.clear();
+            }
+        }
+    };
+
+    // Phase 1: big subproblems, one at a time, with parallel searches.
+    std::vector<Task> tasks (1, Task{0, {}});
+    for (int v = 0; v < V; v++)
+        if (comp[v].load(std::memory_order_relaxed) == -1)
+            tasks[0].verts.push_back(v);
+    if (tasks[0].verts.empty())
+        tasks.clear();
+    std::vector<Task> small;
+    while (!tasks.empty()) {
+        Task task = std::move(tasks.back());
+        tasks.pop_back();
+        if (task.verts.size() < PARALLEL_MIN || T == 1)
+            small.push_back(std::move(task));
+        else
+            split(task, parallelSearch, tasks);
+    }
+
+    // Phase 2: small subproblems, spread over the threads.
+    ParallelFor(small.size(), T, 1, [&](int, std::size_t first, std::size_t last) {
+        std::vector<Task> pending;
+        for (std::size_t i = first; i < last; i++) {
+            pending.push_back(std::move(small[i]));
+            while (!pending.empty()) {
+                Task task = std::move(pending.back());
+                pending.pop_back();
+                split(task, sequentialSearch, pending);
+            }
+        }
+    });
+
+    // Renumber the components densely.
+    std::vector<int> id (nextComp.load(), -1), result (V);
+    int components = 0;
+    for (int v = 0; v < V; v++) {
+        int &c = id[comp[v].load(std::memory_order_relaxed)];
+        if (c == -1)
+            c = components++;
+        result[v] = c;
+    }
+    return result;
+}
+
+#endif  /* StronglyConnected_hpp */
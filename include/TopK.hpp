@@ -0,0 +1,143 @@
+#ifndef TopK_hpp
+#define TopK_hpp
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "Priority_Queue.hpp"
+#include "Vector.hpp"
+
+//
+// Keeps the k highest-ranked elements of a stream under C, in the sense of
+// Priority_Queue: with the default std::less<T>, the k largest. They sit in
+// a heap whose front is the lowest of them, the threshold a newcomer has to
+// beat; as the threshold only rises, most of a long stream is rejected by a
+// single comparison, and an accepted element replaces the front in one
+// sift-down rather than a push and a pop.
+//
+template<typename T, typename C = std::less<T>>
+class TopK {
+public:
+    explicit TopK(size_t k, const C &c = C());
+
+    //
+    // Offers elem, returning whether it was kept (for now).
+    //
+    // Time Complexity: O(1) if rejected, O(lg k) otherwise
+    //
+    bool push(T elem);
+
+    //
+    // Offers a whole batch. While the heap is not yet full the batch is
+    // appended in bulk and heapified once, in linear time.
+    //
+    template<typename InputIterator>
+    void push(InputIterator first, InputIterator last);
+
+    //
+    // The lowest-ranked element kept. The heap must not be empty.
+    //
+    const T& threshold() const;
+
+    size_t size() const;
+    size_t k() const;
+    bool full() const;
+
+    //
+    // Removes and returns the elements kept, highest-ranked first.
+    //
+    // Time Complexity: O(k lg k)
+    //
+    Vector<T> take();
+
+private:
+    // ranks the other way round, putting the lowest kept element in front
+    struct Inverted {
+        C comp;
+        bool operator()(const T &a, const T &b) const
+        {
+            return comp(b, a);
+        }
+    };
+
+    Priority_Queue<T, Inverted> q;
+    C comp;
+    size_t k_;
+
+    bool beats_threshold(const T &elem) const;
+};
+
+template<typename T, typename C>
+TopK<T, C>::TopK(size_t k, const C &c)
+: q(Inverted{c}), comp(c), k_{k}
+{
+}
+
+template<typename T, typename C>
+bool TopK<T, C>::push(T elem)
+{
+    if (!full()) {
+        q.push(std::move(elem));
+        return true;
+    }
+    if (!beats_threshold(elem))
+        return false;
+    q.replace_top(std::move(elem));
+    return true;
+}
+
+template<typename T, typename C>
+template<typename InputIterator>
+void TopK<T, C>::push(InputIterator first, InputIterator last)
+{
+    if (!full() && first != last) {
+        Vector<T> filled (q.data());
+        for (; first != last && filled.size() < k_; ++first)
+            filled.push_back(*first);
+        q = Priority_Queue<T, Inverted>(filled, Inverted{comp});
+    }
+    for (; first != last; ++first)
+        if (beats_threshold(*first))
+            q.replace_top(*first);
+}
+
+template<typename T, typename C>
+const T& TopK<T, C>::threshold() const
+{
+    return q.front();
+}
+
+template<typename T, typename C>
+size_t TopK<T, C>::size() const
+{
+    return q.size();
+}
+
+template<typename T, typename C>
+size_t TopK<T, C>::k() const
+{
+    return k_;
+}
+
+template<typename T, typename C>
+bool TopK<T, C>::full() const
+{
+    return q.size() >= k_;
+}
+
+template<typename T, typename C>
+Vector<T> TopK<T, C>::take()
+{
+    Vector<T> best (q.size());
+    for (size_t i = q.size(); i > 0; i--)
+        best[i - 1] = q.pop();
+    return best;
+}
+
+template<typename T, typename C>
+bool TopK<T, C>::beats_threshold(const T &elem) const
+{
+    return k_ > 0 && comp(q.front(), elem);
+}
+
+#endif  /* TopK_hpp */
@@ -12,6 +12,8 @@
 #include <iterator>
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 
 // Source: https://github.com/gcc-mirror/gcc/blob/7b35a939b8cb869efb830701cef4fa1dc5ff4020/libstdc%2B%2B-v3/include/bits/stl_iterator_base_types.h#L230
 template<typename _InIter>
@@ -172,8 +174,8 @@ public:
     void shrink_to_fit();
     
     void clear();
-    void push_back(T elem);
-    T pop_back();
+    void push_back(T elem);  // by value, so elem may alias the vector
+    T pop_back();  // moves the element out
     void resize(int size);
     
     ~Vector();  // destructor
@@ -395,7 +397,7 @@ void Vector<T>::push_back(T elem)
 {
     if (sz == cap)
         expand_capacity();
-    arr[sz++] = elem;
+    arr[sz++] = std::move(elem);
 }
 
 template<typename T>
@@ -403,7 +405,7 @@ T Vector<T>::pop_back()
 {
     if (sz == 0)
         throw new std::out_of_range("Cannot pop back an empty vector.");
-    return arr[--sz];
+    return std::move(arr[--sz]);
 }
 
 template<typename T>
@@ -0,0 +1,83 @@
+#include <algorithm>
+#include "CompressedGraph.hpp"
+#include "GraphAlgorithms.hpp"
+
+namespace {
+
+inline std::uint32_t ZigZag(std::int32_t x)
+{
+    return (static_cast<std::uint32_t>(x) << 1) ^ static_cast<std::uint32_t>(x >> 31);
+}
+
+inline std::int32_t UnZigZag(std::uint32_t x)
+{
+    return static_cast<std::int32_t>((x >> 1) ^ (~(x & 1) + 1));
+}
+
+inline void WriteVarint(std::uint32_t x, std::vector<std::uint8_t> &out)
+{
+    while (x >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(x));
+}
+
+inline std::uint32_t ReadVarint(const std::uint8_t *&p)
+{
+    std::uint32_t x = *p & 0x7f;
+    for (int shift = 7; *p++ & 0x80; shift += 7)
+        x |= static_cast<std::uint32_t>(*p & 0x7f) << shift;
+    return x;
+}
+
+}  // namespace
+
+void CompressedGraph::NeighborIterator::Decode()
+{
+    if (at_ == end_)
+        return;
+    std::uint32_t gap = ReadVarint(next_);
+    // the first destination may lie below the source, later gaps never do
+    cur_.first += first_ ? UnZigZag(gap) : static_cast<std::int32_t>(gap);
+    cur_.second = UnZigZag(ReadVarint(next_));
+    first_ = false;
+}
+
+int CompressedGraph::V() const
+{
+    return V_;
+}
+
+CompressedGraph::NeighborRange CompressedGraph::Neighbors(int v) const
+{
+    return NeighborRange(bytes_.data() + offset_[v], bytes_.data() + offset_[v + 1], v);
+}
+
+std::size_t CompressedGraph::MemoryUsage() const
+{
+    return offset_.capacity() * sizeof(std::uint64_t) + bytes_.capacity();
+}
+
+std::vector<int> CompressedGraph::PrimAlgorithm() const
+{
+    return PrimMST(*this);
+}
+
+std::vector<int> CompressedGraph::BFS(int src) const
+{
+    return BreadthFirstSearch(*this, src);
+}
+
+void CompressedGraph::Encode(int src, std::vector<std::pair<int, int>> &nbrs,
+                             std::vector<std::uint8_t> &out)
+{
+    std::sort(nbrs.begin(), nbrs.end());
+    int prev = src;
+    for (std::size_t e = 0; e < nbrs.size(); e++) {
+        const int gap = nbrs[e].first - prev;
+        WriteVarint(e == 0 ? ZigZag(gap) : static_cast<std::uint32_t>(gap), out);
+        WriteVarint(ZigZag(nbrs[e].second), out);
+        prev = nbrs[e].first;
+    }
+}
@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include "CsrGraph.hpp"
+#include "GraphAlgorithms.hpp"
+#include "Parallel.hpp"
+
+CsrGraph::CsrGraph(int V, const std::vector<Edge> &edges, const CsrOptions &opts)
+: V_{V}, start_(V + 1, 0)
+{
+    const int T = ResolveThreads(opts.numThreads);
+    const std::size_t m = edges.size();
+    if (V == 0)
+        return;
+
+    // Bucket b holds the vertices v with floor(v * B / V) == b. Several
+    // buckets per thread keep the second pass balanced on skewed graphs.
+    const std::size_t B = std::min<std::size_t>(V, 16 * static_cast<std::size_t>(T));
+    auto bucketOf = [B, V](int v) {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(v) * B / V);
+    };
+    auto bucketFirst = [B, V](std::size_t b) {
+        return static_cast<int>((b * static_cast<std::uint64_t>(V) + B - 1) / B);
+    };
+    auto sliceFirst = [m, T](std::size_t t) {
+        return m * t / T;
+    };
+
+    // Pass 1: histogram every slice of the edge list by source bucket, then
+    // scatter it into a private region of each bucket.
+    std::vector<std::size_t> cursor (T * B, 0);  // indexed by t * B + b
+    ParallelFor(T, T, 1, [&](int, std::size_t t0, std::size_t t1) {
+        for (std::size_t t = t0; t < t1; t++) {
+            std::size_t *count = cursor.data() + t * B;
+            for (std::size_t e = sliceFirst(t); e < sliceFirst(t + 1); e++) {
+                ++count[bucketOf(edges[e].src)];
+                if (opts.undirected)
+                    ++count[bucketOf(edges[e].dest)];
+            }
+        }
+    });
+    std::vector<std::size_t> bucketStart (B + 1, 0);
+    for (std::size_t b = 0, pos = 0; b < B; b++) {
+        bucketStart[b] = pos;
+        for (int t = 0; t < T; t++) {
+            const std::size_t count = cursor[t * B + b];
+            cursor[t * B + b] = pos;
+            pos += count;
+        }
+        bucketStart[b + 1] = pos;
+    }
+    std::vector<Edge> bucketed (bucketStart[B]);
+    ParallelFor(T, T, 1, [&](int, std::size_t t0, std::size_t t1) {
+        for (std::size_t t = t0; t < t1; t++) {
+            std::size_t *next = cursor.data() + t * B;
+            for (std::size_t e = sliceFirst(t); e < sliceFirst(t + 1); e++) {
+                const Edge &edge = edges[e];
+                bucketed[next[bucketOf(edge.src)]++] = edge;
+                if (opts.undirected)
+                    bucketed[next[bucketOf(edge.dest)]++] = {edge.dest, edge.src, edge.weight};
+            }
+        }
+    });
+    std::vector<std::size_t>().swap(cursor);
+
+    // Pass 2: counting sort every bucket by source, straight into adj_, then
+    // sort (and deduplicate) each neighbor list. start_ receives the final
+    // list boundaries; with deduplication, kept[v] records how much of v's
+    // list survived.
+    adj_.resize(bucketed.size());
+    std::vector<std::size_t> kept (opts.dedup ? V : 0);
+    ParallelFor(B, T, 1, [&](int, std::size_t b0, std::size_t b1) {
+        std::vector<std::size_t> next;
+        for (std::size_t b = b0; b < b1; b++) {
+            const int lo = bucketFirst(b), hi = bucketFirst(b + 1);
+            next.assign(hi - lo, 0);
+            for (std::size_t e = bucketStart[b]; e < bucketStart[b + 1]; e++)
+                ++next[bucketed[e].src - lo];
+            std::size_t pos = bucketStart[b];
+            for (int v = lo; v < hi; v++) {
+                const std::size_t degree = next[v - lo];
+                next[v - lo] = pos;
+                pos += degree;
+                start_[v + 1] = pos;
+            }
+            for (std::size_t e = bucketStart[b]; e < bucketStart[b + 1]; e++) {
+                const Edge &edge = bucketed[e];
+                adj_[next[edge.src - lo]++] = {edge.dest, edge.weight};
+            }
+            for (int v = lo; v < hi; v++) {
+                auto first = adj_.begin() + (v == lo ? bucketStart[b] : start_[v]);
+                auto last = adj_.begin() + start_[v + 1];
+                std::sort(first, last);
+                if (opts.dedup) {
+                    // sorted by (dest, weight), so the first of a run is the lightest
+                    auto sameDest = [](const std::pair<int, int> &x, const std::pair<int, int> &y) {
+                        return x.first == y.first;
+                    };
+                    kept[v] = std::unique(first, last, sameDest) - first;
+                }
+            }
+        }
+    });
+    std::vector<Edge>().swap(bucketed);
+
+    // Pass 3: close the gaps left by deduplication.
+    if (opts.dedup) {
+        std::vector<std::size_t> newStart (V + 1, 0);
+        std::partial_sum(kept.begin(), kept.end(), newStart.begin() + 1);
+        std::vector<std::pair<int, int>> compact (newStart[V]);
+        ParallelFor(V, T, 4096, [&](int, std::size_t v0, std::size_t v1) {
+            for (std::size_t v = v0; v < v1; v++)
+                std::copy_n(adj_.begin() + start_[v], kept[v], compact.begin() + newStart[v]);
+        });
+        start_.swap(newStart);
+        adj_.swap(compact);
+    }
+}
+
+int CsrGraph::V() const
+{
+    return V_;
+}
+
+std::size_t CsrGraph::E() const
+{
+    return adj_.size();
+}
+
+std::size_t CsrGraph::Degree(int v) const
+{
+    return start_[v + 1] - start_[v];
+}
+
+CsrGraph::NeighborRange CsrGraph::Neighbors(int v) const
+{
+    return NeighborRange(adj_.data() + start_[v], adj_.data() + start_[v + 1]);
+}
+
+std::vector<int> CsrGraph::PrimAlgorithm() const
+{
+    return PrimMST(*this);
+}
+
+std::vector<int> CsrGraph::BFS(int src) const
+{
+    return BreadthFirstSearch(*this, src);
+}
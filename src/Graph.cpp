@@ -1,52 +1,168 @@
 #include <vector>
-#include <queue>
 #include <numeric>
+#include <algorithm>
 #include "Graph.hpp"
+#include "GraphAlgorithms.hpp"
+#include "Parallel.hpp"
+#include "SetIntersection.hpp"
+#include "ShortestPaths.hpp"
+#include "StronglyConnected.hpp"
 
 // Debugging Purposes
 #include <string>
 #include <iostream>
 
-Graph::Graph(int V) : V_{V} {}
+Graph::Graph(int V, bool directed) : V_{V}, directed_{directed}, ls_(V) {}
 
 void Graph::AddEdge(int src, int dest, int weight)
 {
     ls_[src].push_back({dest, weight});
-    ls_[dest].push_back({src, weight});
+    if (!directed_)
+        ls_[dest].push_back({src, weight});
+    sorted_ = false;
+}
+
+int Graph::V() const
+{
+    return V_;
+}
+
+bool Graph::Directed() const
+{
+    return directed_;
+}
+
+const std::vector<std::pair<int, int>>& Graph::Neighbors(int v) const
+{
+    return ls_[v];
 }
 
 std::vector<int> Graph::PrimAlgorithm()
 {
-    const int INF = 1000000007;
-    const int ROOT = 0;  // picking arbitarily suffices
+    return PrimMST(*this);
+}
 
-    std::vector<int> key (V_, INF);
-    auto qcomp = [&key](int x, int y) {
-        return key[x] > key[y];
+std::vector<int> Graph::BFS(int src) const
+{
+    return BreadthFirstSearch(*this, src);
+}
+
+std::vector<int> Graph::CommonNeighbors(int u, int v)
+{
+    SortNeighbors();
+    const int *nu = nbrs_.data() + nbrStart_[u];
+    const int *nv = nbrs_.data() + nbrStart_[v];
+    const std::size_t du = nbrStart_[u + 1] - nbrStart_[u];
+    const std::size_t dv = nbrStart_[v + 1] - nbrStart_[v];
+    std::vector<int> common (std::min(du, dv));
+    common.resize(Intersect(nu, du, nv, dv, common.data()));
+    return common;
+}
+
+long long Graph::CountTriangles(int numThreads)
+{
+    SortNeighbors();
+    auto degree = [this](int v) {
+        return nbrStart_[v + 1] - nbrStart_[v];
+    };
+    auto precedes = [&degree](int x, int y) {
+        return degree(x) < degree(y) || (degree(x) == degree(y) && x < y);
     };
 
-    std::vector<int> elems (V_);
-    std::iota(elems.begin(), elems.end(), 0);
-    std::vector<int> parent (V_, -1);
-    std::vector<bool> in_q (V_, true);
-
-    key[ROOT] = 0, parent[ROOT] = ROOT;
-    std::priority_queue<int, std::vector<int>, decltype(qcomp)> q (qcomp, elems);
-    
-    while (!q.empty()) {
-        int src = q.top(); q.pop();
-        // check if the node is already processed
-        if (!in_q[src]) continue;
-        in_q[src] = false;
-        for (std::pair<int, int> edge : ls_[src]) {
-            int dest = edge.first, w = edge.second;
-            if (in_q[dest] && w < key[dest]) {
-                key[dest] = w, parent[dest] = src;
-                // necessary, as there is no decrease-key operation
-                q.push(dest);  
+    // Orient every edge towards its higher-ranked endpoint. Filtering keeps
+    // the out-neighbor lists sorted by id, which the intersection requires.
+    std::vector<std::size_t> outStart (V_ + 1, 0);
+    for (int v = 0; v < V_; v++)
+        for (std::size_t e = nbrStart_[v]; e < nbrStart_[v + 1]; e++)
+            outStart[v + 1] += precedes(v, nbrs_[e]);
+    std::partial_sum(outStart.begin(), outStart.end(), outStart.begin());
+    std::vector<int> out (outStart[V_]);
+    std::size_t o = 0;
+    for (int v = 0; v < V_; v++)
+        for (std::size_t e = nbrStart_[v]; e < nbrStart_[v + 1]; e++)
+            if (precedes(v, nbrs_[e]))
+                out[o++] = nbrs_[e];
+
+    numThreads = ResolveThreads(numThreads);
+    std::vector<long long> partial (numThreads, 0);
+    ParallelFor(V_, numThreads, 64, [&](int tid, std::size_t first, std::size_t last) {
+        long long count = 0;
+        for (std::size_t u = first; u < last; u++) {
+            const int *ou = out.data() + outStart[u];
+            const std::size_t du = outStart[u + 1] - outStart[u];
+            for (std::size_t e = 0; e < du; e++) {
+                const int v = ou[e];
+                count += Intersect(ou, du, out.data() + outStart[v],
+                                   outStart[v + 1] - outStart[v]);
             }
         }
+        partial[tid] += count;
+    });
+    return std::accumulate(partial.begin(), partial.end(), 0LL);
+}
+
+std::vector<int> Graph::AllPairsShortestPaths(int numThreads) const
+{
+    long long E = 0;
+    for (const auto &ls : ls_)
+        E += ls.size();
+    const int lgV = V_ > 1 ? 32 - __builtin_clz(V_ - 1) : 1;
+
+    std::vector<int> dist;
+    // Each heap operation of Johnson's algorithm costs dozens of the vector
+    // min-plus steps Floyd-Warshall performs 8 at a time.
+    if (E * lgV * 64 < 1LL * V_ * V_) {
+        if (!Johnson(*this, dist, numThreads))
+            dist.clear();
+        return dist;
     }
-    return parent;
+    dist.assign(1LL * V_ * V_, INF_DIST);
+    for (int u = 0; u < V_; u++) {
+        dist[1LL * u * V_ + u] = 0;
+        for (std::pair<int, int> edge : ls_[u]) {
+            int &d = dist[1LL * u * V_ + edge.first];
+            d = std::min(d, edge.second);
+        }
+    }
+    if (!FloydWarshall(dist, V_, numThreads))
+        dist.clear();
+    return dist;
 }
 
+std::vector<int> Graph::StronglyConnectedComponents() const
+{
+    return TarjanSCC(*this);
+}
+
+std::vector<int> Graph::ParallelStronglyConnectedComponents(int numThreads) const
+{
+    return ForwardBackwardSCC(*this, numThreads);
+}
+
+void Graph::SortNeighbors()
+{
+    if (sorted_)
+        return;
+    // Directed graphs also need the edges entering every vertex.
+    std::vector<std::vector<int>> in (directed_ ? V_ : 0);
+    for (int u = 0; directed_ && u < V_; u++)
+        for (std::pair<int, int> edge : ls_[u])
+            in[edge.first].push_back(u);
+
+    nbrStart_.assign(V_ + 1, 0);
+    nbrs_.clear();
+    for (int v = 0; v < V_; v++) {
+        const std::size_t first = nbrs_.size();
+        for (std::pair<int, int> edge : ls_[v])
+            if (edge.first != v)
+                nbrs_.push_back(edge.first);
+        if (directed_)
+            for (int u : in[v])
+                if (u != v)
+                    nbrs_.push_back(u);
+        std::sort(nbrs_.begin() + first, nbrs_.end());
+        nbrs_.erase(std::unique(nbrs_.begin() + first, nbrs_.end()), nbrs_.end());
+        nbrStart_[v + 1] = nbrs_.size();
+    }
+    sorted_ = true;
+}
@@ -0,0 +1,237 @@
+#include <algorithm>
+#include "SetIntersection.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#endif
+
+namespace {
+
+template<bool Write>
+std::size_t Merge(const int *a, std::size_t na, const int *b, std::size_t nb,
+                  int *out)
+{
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            if (Write)
+                out[k] = a[i];
+            ++k, ++i, ++j;
+        }
+    }
+    return k;
+}
+
+template<bool Write>
+std::size_t Gallop(const int *a, std::size_t na, const int *b, std::size_t nb,
+                   int *out)
+{
+    if (na > nb)
+        std::swap(a, b), std::swap(na, nb);
+    std::size_t j = 0, k = 0;
+    for (std::size_t i = 0; i < na && j < nb; i++) {
+        const int x = a[i];
+        // double the step until it overshoots, then binary search the gap
+        std::size_t bound = 1;
+        while (j + bound < nb && b[j + bound] < x)
+            bound *= 2;
+        const int *first = b + j + bound / 2;
+        const int *last = b + std::min(j + bound + 1, nb);
+        j = std::lower_bound(first, last, x) - b;
+        if (j < nb && b[j] == x) {
+            if (Write)
+                out[k] = x;
+            ++k, ++j;
+        }
+    }
+    return k;
+}
+
+// Writes the lanes of a vector selected by `mask` to out[k..] one at a time.
+// Used for the last few results where a full vector store would overrun the
+// caller's buffer.
+inline std::size_t EmitMasked(const int *lanes, int mask, int *out, std::size_t k)
+{
+    for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        if (mask & 1)
+            out[k++] = lanes[lane];
+    return k;
+}
+
+#if defined(__AVX2__)
+
+// kPermute8.idx[mask] gathers the lanes selected by an 8-bit mask to the
+// front of a vector.
+struct PermuteTable8 {
+    alignas(32) int idx[256][8];
+};
+
+constexpr PermuteTable8 MakePermuteTable8()
+{
+    PermuteTable8 t {};
+    for (int mask = 0; mask < 256; mask++) {
+        int k = 0;
+        for (int lane = 0; lane < 8; lane++)
+            if (mask & (1 << lane))
+                t.idx[mask][k++] = lane;
+    }
+    return t;
+}
+
+constexpr PermuteTable8 kPermute8 = MakePermuteTable8();
+
+template<bool Write>
+std::size_t VectorIntersect(const int *a, std::size_t na, const int *b,
+                            std::size_t nb, int *out)
+{
+    const std::size_t cap = std::min(na, nb);
+    const std::size_t na8 = na & ~std::size_t{7}, nb8 = nb & ~std::size_t{7};
+    const __m256i rot = _mm256_set_epi32(0, 7, 6, 5, 4, 3, 2, 1);
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na8 && j < nb8) {
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i eq = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; r++) {
+            vb = _mm256_permutevar8x32_epi32(vb, rot);
+            eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+        }
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+        if (!Write) {
+            k += __builtin_popcount(mask);
+        } else if (k + 8 <= cap) {
+            const __m256i perm = _mm256_load_si256(
+                reinterpret_cast<const __m256i*>(kPermute8.idx[mask]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + k),
+                                _mm256_permutevar8x32_epi32(va, perm));
+            k += __builtin_popcount(mask);
+        } else {
+            k = EmitMasked(a + i, mask, out, k);
+        }
+        const int amax = a[i + 7], bmax = b[j + 7];
+        i += amax <= bmax ? 8 : 0;
+        j += bmax <= amax ? 8 : 0;
+    }
+    return k + Merge<Write>(a + i, na - i, b + j, nb - j, Write ? out + k : nullptr);
+}
+
+#elif defined(__SSE2__)
+
+#if defined(__SSSE3__)
+// kShuffle4.bytes[mask] gathers the 32-bit lanes selected by a 4-bit mask to
+// the front of a vector; 0x80 zeroes the unused bytes.
+struct ShuffleTable4 {
+    alignas(16) unsigned char bytes[16][16];
+};
+
+constexpr ShuffleTable4 MakeShuffleTable4()
+{
+    ShuffleTable4 t {};
+    for (int mask = 0; mask < 16; mask++) {
+        int k = 0;
+        for (int lane = 0; lane < 4; lane++)
+            if (mask & (1 << lane))
+                for (int byte = 0; byte < 4; byte++)
+                    t.bytes[mask][k++] = 4 * lane + byte;
+        while (k < 16)
+            t.bytes[mask][k++] = 0x80;
+    }
+    return t;
+}
+
+constexpr ShuffleTable4 kShuffle4 = MakeShuffleTable4();
+#endif
+
+template<bool Write>
+std::size_t VectorIntersect(const int *a, std::size_t na, const int *b,
+                            std::size_t nb, int *out)
+{
+#if defined(__SSSE3__)
+    const std::size_t cap = std::min(na, nb);
+#endif
+    const std::size_t na4 = na & ~std::size_t{3}, nb4 = nb & ~std::size_t{3};
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na4 && j < nb4) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        const __m128i eq = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        const int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        if (!Write) {
+            k += __builtin_popcount(mask);
+        } else {
+#if defined(__SSSE3__)
+            if (k + 4 <= cap) {
+                const __m128i shuf = _mm_load_si128(
+                    reinterpret_cast<const __m128i*>(kShuffle4.bytes[mask]));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k),
+                                 _mm_shuffle_epi8(va, shuf));
+                k += __builtin_popcount(mask);
+            } else {
+                k = EmitMasked(a + i, mask, out, k);
+            }
+#else
+            k = EmitMasked(a + i, mask, out, k);
+#endif
+        }
+        const int amax = a[i + 3], bmax = b[j + 3];
+        i += amax <= bmax ? 4 : 0;
+        j += bmax <= amax ? 4 : 0;
+    }
+    return k + Merge<Write>(a + i, na - i, b + j, nb - j, Write ? out + k : nullptr);
+}
+
+#else
+
+template<bool Write>
+std::size_t VectorIntersect(const int *a, std::size_t na, const int *b,
+                            std::size_t nb, int *out)
+{
+    return Merge<Write>(a, na, b, nb, out);
+}
+
+#endif
+
+}  // namespace
+
+std::size_t IntersectMerge(const int *a, std::size_t na, const int *b,
+                           std::size_t nb, int *out)
+{
+    return out ? Merge<true>(a, na, b, nb, out) : Merge<false>(a, na, b, nb, out);
+}
+
+std::size_t IntersectGalloping(const int *a, std::size_t na, const int *b,
+                               std::size_t nb, int *out)
+{
+    return out ? Gallop<true>(a, na, b, nb, out) : Gallop<false>(a, na, b, nb, out);
+}
+
+std::size_t IntersectSIMD(const int *a, std::size_t na, const int *b,
+                          std::size_t nb, int *out)
+{
+    return out ? VectorIntersect<true>(a, na, b, nb, out)
+               : VectorIntersect<false>(a, na, b, nb, out);
+}
+
+std::size_t Intersect(const int *a, std::size_t na, const int *b,
+                      std::size_t nb, int *out)
+{
+    // Beyond this size ratio, lg(larger) probes per element of the smaller
+    // array beat streaming through the larger one.
+    constexpr std::size_t SKEW {32};
+    if (na * SKEW < nb || nb * SKEW < na)
+        return IntersectGalloping(a, na, b, nb, out);
+    return IntersectSIMD(a, na, b, nb, out);
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include "ShortestPaths.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+
+namespace {
+
+constexpr int BLOCK {64};        // tile edge; three int tiles take 48 KiB
+constexpr int HALF_INF {INF_DIST / 2};
+
+//
+// c[j] = clamp(min(c[j], a + b[j])) for j in [0, BLOCK). Clamping to
+// [-INF_DIST, INF_DIST] keeps every sum within int range even when a
+// negative cycle drives distances down.
+//
+inline void MinPlusRow(int *c, int a, const int *b)
+{
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi32(a);
+    const __m256i lo = _mm256_set1_epi32(-INF_DIST);
+    for (int j = 0; j < BLOCK; j += 8) {
+        __m256i vc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        vc = _mm256_max_epi32(_mm256_min_epi32(vc, _mm256_add_epi32(va, vb)), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), vc);
+    }
+#elif defined(__SSE4_1__)
+    const __m128i va = _mm_set1_epi32(a);
+    const __m128i lo = _mm_set1_epi32(-INF_DIST);
+    for (int j = 0; j < BLOCK; j += 4) {
+        __m128i vc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + j));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        vc = _mm_max_epi32(_mm_min_epi32(vc, _mm_add_epi32(va, vb)), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(c + j), vc);
+    }
+#else
+    for (int j = 0; j < BLOCK; j++)
+        c[j] = std::max(std::min(c[j], a + b[j]), -INF_DIST);
+#endif
+}
+
+//
+// Relaxes tile (bi, bj) through the intermediate vertices of block bk:
+// C = min(C, A (min,+) B) with A = tile (bi, bk) and B = tile (bk, bj).
+// Iterating k outermost keeps this correct when C aliases A or B, which is
+// what the diagonal, row and column phases rely on.
+//
+void RelaxTile(int *d, int N, int bi, int bj, int bk)
+{
+    int *c = d + static_cast<std::size_t>(bi) * BLOCK * N + bj * BLOCK;
+    const int *a = d + static_cast<std::size_t>(bi) * BLOCK * N + bk * BLOCK;
+    const int *b = d + static_cast<std::size_t>(bk) * BLOCK * N + bj * BLOCK;
+    for (int k = 0; k < BLOCK; k++) {
+        const int *bk_row = b + static_cast<std::size_t>(k) * N;
+        for (int i = 0; i < BLOCK; i++) {
+            const int aik = a[static_cast<std::size_t>(i) * N + k];
+            if (aik > HALF_INF)
+                continue;  // no path i -> k, nothing to relax
+            MinPlusRow(c + static_cast<std::size_t>(i) * N, aik, bk_row);
+        }
+    }
+}
+
+}  // namespace
+
+bool FloydWarshall(std::vector<int> &dist, int n, int numThreads)
+{
+    // Pad to whole tiles; padding vertices have no edges.
+    const int nb = (n + BLOCK - 1) / BLOCK, N = nb * BLOCK;
+    std::vector<int> d (static_cast<std::size_t>(N) * N, INF_DIST);
+    for (int i = 0; i < n; i++)
+        std::copy_n(dist.begin() + static_cast<std::size_t>(i) * n, n,
+                    d.begin() + static_cast<std::size_t>(i) * N);
+
+    for (int bk = 0; bk < nb; bk++) {
+        RelaxTile(d.data(), N, bk, bk, bk);
+        // row and column tiles only depend on the diagonal tile
+        ParallelFor(2 * nb, numThreads, 1, [&](int, std::size_t first, std::size_t last) {
+            for (std::size_t t = first; t < last; t++) {
+                const int other = t / 2;
+                if (other == bk)
+                    continue;
+                if (t % 2 == 0)
+                    RelaxTile(d.data(), N, bk, other, bk);
+                else
+                    RelaxTile(d.data(), N, other, bk, bk);
+            }
+        });
+        // the rest only depend on their row and column tiles
+        ParallelFor(static_cast<std::size_t>(nb) * nb, numThreads, 1,
+                    [&](int, std::size_t first, std::size_t last) {
+            for (std::size_t t = first; t < last; t++) {
+                const int bi = t / nb, bj = t % nb;
+                if (bi != bk && bj != bk)
+                    RelaxTile(d.data(), N, bi, bj, bk);
+            }
+        });
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (d[static_cast<std::size_t>(i) * N + i] < 0)
+            return false;
+        for (int j = 0; j < n; j++) {
+            const int x = d[static_cast<std::size_t>(i) * N + j];
+            dist[static_cast<std::size_t>(i) * n + j] = x > HALF_INF ? INF_DIST : x;
+        }
+    }
+    return true;
+}
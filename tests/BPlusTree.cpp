@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BPlusTree.hpp"
+
+TEST(BPlusTree, NodeLowerBound) {
+    std::vector<std::int32_t> keys;
+    std::vector<std::int64_t> wide;
+    for (int i = 0; i < 37; i++)
+        keys.push_back(3 * i - 50), wide.push_back((3ll * i - 50) * (std::int64_t{1} << 33));
+    for (int x = -60; x < 70; x++) {
+        const int expected = std::lower_bound(keys.begin(), keys.end(), x) - keys.begin();
+        EXPECT_EQ(NodeLowerBound(keys.data(), keys.size(), x, std::less<std::int32_t>()), expected);
+        const std::int64_t y = x * (std::int64_t{1} << 33);
+        EXPECT_EQ(NodeLowerBound(wide.data(), wide.size(), y, std::less<std::int64_t>()), expected);
+    }
+}
+
+TEST(BPlusTree, SetInterface) {
+    BPlusTree<int> t;
+    EXPECT_EQ(t.Minimum(), t.end());
+    for (int x : {30, 10, 50, 20, 40})
+        EXPECT_TRUE(t.Insert(x));
+    EXPECT_FALSE(t.Insert(20));
+    EXPECT_EQ(t.size(), 5u);
+    EXPECT_EQ(*t.Minimum(), 10);
+    EXPECT_EQ(*t.Maximum(), 50);
+    EXPECT_EQ(*t.Successor(t.Search(20)), 30);
+    EXPECT_EQ(*t.Predecessor(t.Search(20)), 10);
+    EXPECT_EQ(t.Predecessor(t.Minimum()), t.end());
+    EXPECT_EQ(t.Successor(t.Maximum()), t.end());
+    EXPECT_EQ(t.Search(25), t.end());
+    EXPECT_EQ(*t.LowerBound(25), 30);
+    EXPECT_EQ(*t.UpperBound(30), 40);
+    EXPECT_EQ(t.LowerBound(51), t.end());
+    EXPECT_EQ(*--t.end(), 50);
+}
+
+TEST(BPlusTree, MapAndRanges) {
+    BPlusTree<std::string, int, std::less<std::string>, 4> t;  // tiny nodes, deep tree
+    std::map<std::string, int> ref;
+    for (int i = 0; i < 2000; i++) {
+        const std::string key = std::to_string(i * 7919 % 2000);
+        EXPECT_TRUE(t.Insert(key, i));
+        ref[key] = i;
+    }
+    EXPECT_TRUE(std::equal(t.begin(), t.end(), ref.begin(), ref.end(),
+                           [](const std::string &a, const std::pair<const std::string, int> &b) {
+        return a == b.first;
+    }));
+    t.Search("1234").value() = -1;
+    EXPECT_EQ(t.Search("1234").value(), -1);
+    EXPECT_EQ(t.Search("777").value(), ref["777"]);
+
+    // keys in ["3", "4")
+    std::vector<std::string> range (t.LowerBound("3"), t.LowerBound("4"));
+    EXPECT_EQ(range.size(), 111u);
+    EXPECT_EQ(range.front(), "3");
+    EXPECT_EQ(range.back(), "399");
+}
+
+template<int B>
+void RandomOperations()
+{
+    BPlusTree<std::int64_t, void, std::less<std::int64_t>, B> t;
+    std::set<std::int64_t> ref;
+    std::srand(43);
+    for (int i = 0; i < 200000; i++) {
+        const std::int64_t x = std::rand() % 20000;
+        if (std::rand() % 5 < 3)
+            ASSERT_EQ(t.Insert(x), ref.insert(x).second);
+        else
+            ASSERT_EQ(t.Erase(x), ref.erase(x) > 0);
+        if (i % 20000 == 0 || i % 997 == 0) {
+            ASSERT_EQ(t.size(), ref.size());
+            ASSERT_TRUE(std::equal(t.begin(), t.end(), ref.begin(), ref.end()));
+            ASSERT_TRUE(std::equal(std::make_reverse_iterator(t.end()),
+                                   std::make_reverse_iterator(t.begin()),
+                                   ref.rbegin(), ref.rend()));
+        }
+    }
+    for (std::int64_t x = -1; x <= 20000; x++) {
+        auto it = ref.lower_bound(x);
+        ASSERT_EQ(t.LowerBound(x) == t.end() ? -1 : *t.LowerBound(x), it == ref.end() ? -1 : *it);
+    }
+    // erase everything, which collapses the tree level by level
+    for (std::int64_t x : std::vector<std::int64_t>(ref.begin(), ref.end()))
+        ASSERT_TRUE(t.Erase(x));
+    EXPECT_TRUE(t.empty());
+    EXPECT_EQ(t.begin(), t.end());
+    EXPECT_TRUE(t.Insert(1));
+}
+
+TEST(BPlusTree, RandomOperations) {
+    RandomOperations<4>();
+    RandomOperations<5>();
+    RandomOperations<32>();
+}
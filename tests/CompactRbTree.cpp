@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactRbTree.hpp"
+#include "RbTree.hpp"
+
+TEST(CompactRbTree, NodeSizes) {
+    EXPECT_EQ((CompactRbTree<int>::NODE_BYTES), 16u);
+    EXPECT_EQ((CompactRbTree<std::uint64_t>::NODE_BYTES), 24u);
+    EXPECT_EQ((CompactRbTree<std::uint64_t, std::less<std::uint64_t>, false>::NODE_BYTES), 32u);
+    EXPECT_LT((CompactRbTree<std::uint64_t, std::less<std::uint64_t>, false>::NODE_BYTES),
+              sizeof(RbNode<std::uint64_t>));
+}
+
+template<typename Tree>
+void CheckAgainstMultiset()
+{
+    Tree t;
+    std::multiset<int> ref;
+    std::srand(17);
+    for (int i = 0; i < 60000; i++) {
+        const int x = std::rand() % 3000;
+        if (std::rand() % 3 == 0) {
+            auto found = ref.find(x);
+            ASSERT_EQ(t.Erase(x), found != ref.end());
+            if (found != ref.end())
+                ref.erase(found);
+        } else {
+            t.Insert(x);
+            ref.insert(x);
+        }
+        const int *lb = t.LowerBound(x);
+        auto it = ref.lower_bound(x);
+        ASSERT_EQ(lb == nullptr, it == ref.end());
+        if (lb != nullptr) {
+            ASSERT_EQ(*lb, *it);
+        }
+        if (i % 1000 == 0) {
+            ASSERT_TRUE(t.IsValid());
+        }
+    }
+    ASSERT_TRUE(t.IsValid());
+    std::vector<int> keys;
+    t.ForEach([&](int key) { keys.push_back(key); });
+    EXPECT_EQ(keys, std::vector<int>(ref.begin(), ref.end()));
+    EXPECT_EQ(t.Size(), ref.size());
+    EXPECT_EQ(*t.Minimum(), *ref.begin());
+    EXPECT_EQ(*t.Maximum(), *ref.rbegin());
+    EXPECT_EQ(t.Search(-1), nullptr);
+
+    t.Clear();
+    EXPECT_EQ(t.Size(), 0u);
+    EXPECT_EQ(t.Minimum(), nullptr);
+    t.Insert(4);
+    EXPECT_EQ(*t.Search(4), 4);
+    EXPECT_TRUE(t.IsValid());
+}
+
+TEST(CompactRbTree, IndexedMatchesMultiset) {
+    CheckAgainstMultiset<CompactRbTree<int>>();
+}
+
+TEST(CompactRbTree, PointerMatchesMultiset) {
+    CheckAgainstMultiset<CompactRbTree<int, std::less<int>, false>>();
+}
+
+TEST(CompactRbTree, OwningKeys) {
+    CompactRbTree<std::string> indexed;
+    CompactRbTree<std::string, std::less<std::string>, false> pointers;
+    for (int i = 0; i < 2000; i++) {
+        indexed.Insert(std::string(50, 'k') + std::to_string(i));
+        pointers.Insert(std::string(50, 'k') + std::to_string(i));
+    }
+    for (int i = 0; i < 2000; i += 3) {
+        EXPECT_TRUE(indexed.Erase(std::string(50, 'k') + std::to_string(i)));
+        EXPECT_TRUE(pointers.Erase(std::string(50, 'k') + std::to_string(i)));
+    }
+    EXPECT_TRUE(indexed.IsValid());
+    EXPECT_TRUE(pointers.IsValid());
+    EXPECT_EQ(indexed.Size(), pointers.Size());
+}
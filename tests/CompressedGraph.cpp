@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Graph.hpp"
+#include "CompressedGraph.hpp"
+
+long long TreeWeight(const Graph &g, const std::vector<int> &parent)
+{
+    long long total = 0;
+    for (int v = 0; v < g.V(); v++) {
+        if (parent[v] == v || parent[v] == -1)
+            continue;
+        int best = 1000000007;
+        for (std::pair<int, int> edge : g.Neighbors(v))
+            if (edge.first == parent[v])
+                best = std::min(best, edge.second);
+        total += best;
+    }
+    return total;
+}
+
+class CompressedGraphFixture : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        srand(11);
+        for (int e = 0; e < m; e++) {
+            // mostly local edges, as in real-world graphs, with a few long ones
+            int u = rand() % n;
+            int v = e % 10 ? (u + 1 + rand() % 16) % n : rand() % n;
+            g.AddEdge(u, v, rand() % 2000 - 100);
+        }
+    }
+
+    static constexpr int n = 5000, m = 40000;
+    Graph g {n};
+};
+
+TEST_F(CompressedGraphFixture, DecodesSortedNeighbors) {
+    CompressedGraph cg(g, 3);
+    ASSERT_EQ(cg.V(), n);
+    for (int v = 0; v < n; v++) {
+        std::vector<std::pair<int, int>> expected (g.Neighbors(v));
+        std::sort(expected.begin(), expected.end());
+        std::vector<std::pair<int, int>> decoded;
+        for (std::pair<int, int> edge : cg.Neighbors(v))
+            decoded.push_back(edge);
+        ASSERT_EQ(decoded, expected) << "vertex " << v;
+    }
+}
+
+TEST_F(CompressedGraphFixture, SingleThreaded) {
+    CompressedGraph one(g, 1), many(g, 4);
+    for (int v = 0; v < n; v += 97) {
+        auto a = one.Neighbors(v), b = many.Neighbors(v);
+        EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    }
+}
+
+TEST_F(CompressedGraphFixture, HalvesMemory) {
+    CompressedGraph cg(g);
+    const std::size_t plain = n * sizeof(std::vector<std::pair<int, int>>) +
+        2 * m * sizeof(std::pair<int, int>);
+    EXPECT_LE(2 * cg.MemoryUsage(), plain);
+}
+
+TEST_F(CompressedGraphFixture, Algorithms) {
+    CompressedGraph cg(g);
+    EXPECT_EQ(cg.BFS(0), g.BFS(0));
+    EXPECT_EQ(cg.BFS(n / 2), g.BFS(n / 2));
+    EXPECT_EQ(TreeWeight(g, cg.PrimAlgorithm()), TreeWeight(g, g.PrimAlgorithm()));
+}
+
+TEST(CompressedGraph, EmptyAndIsolated) {
+    Graph g(4);
+    g.AddEdge(3, 0, -5);
+    CompressedGraph cg(g);
+    EXPECT_TRUE(cg.Neighbors(1).empty());
+    EXPECT_EQ(*cg.Neighbors(3).begin(), std::make_pair(0, -5));
+    EXPECT_EQ(cg.BFS(0), std::vector<int>({0, -1, -1, 1}));
+}
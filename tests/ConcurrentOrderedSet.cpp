@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentOrderedSet.hpp"
+
+TEST(ConcurrentOrderedSet, MatchesStdSet) {
+    ConcurrentOrderedSet<int> s;
+    std::set<int> ref;
+    std::srand(5);
+    for (int i = 0; i < 100000; i++) {
+        const int x = std::rand() % 4000;
+        switch (std::rand() % 3) {
+        case 0:
+            EXPECT_EQ(s.Insert(x), ref.insert(x).second);
+            break;
+        case 1:
+            EXPECT_EQ(s.Erase(x), ref.erase(x) == 1);
+            break;
+        default: {
+            EXPECT_EQ(s.Contains(x), ref.count(x) == 1);
+            int found = -1;
+            auto it = ref.lower_bound(x);
+            EXPECT_EQ(s.LowerBound(x, found), it != ref.end());
+            if (it != ref.end()) {
+                EXPECT_EQ(found, *it);
+            }
+        }
+        }
+    }
+    EXPECT_EQ(s.Size(), ref.size());
+}
+
+TEST(ConcurrentOrderedSet, ReadersDuringUpdates) {
+    // the even keys stay put while writers churn the odd ones around them,
+    // rotating and freeing nodes under the readers
+    ConcurrentOrderedSet<int> s;
+    const int n = 20000;
+    for (int i = 0; i < n; i += 2)
+        s.Insert(i);
+    std::atomic<bool> done {false};
+    std::atomic<int> misses {0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; w++) {
+        threads.emplace_back([&, w] {
+            std::minstd_rand rng(w + 1);
+            for (int i = 0; i < 40000; i++) {
+                const int x = 2 * (rng() % (n / 2)) + 1;
+                if (rng() % 2)
+                    s.Insert(x);
+                else
+                    s.Erase(x);
+            }
+        });
+    }
+    for (int r = 0; r < 3; r++) {
+        threads.emplace_back([&, r] {
+            std::minstd_rand rng(100 + r);
+            while (!done.load()) {
+                const int x = 2 * (rng() % (n / 2));
+                int next = -1;
+                if (!s.Contains(x) || !s.LowerBound(x, next) || next != x)
+                    misses++;
+            }
+        });
+    }
+    threads[0].join();
+    threads[1].join();
+    done = true;
+    for (size_t i = 2; i < threads.size(); i++)
+        threads[i].join();
+    EXPECT_EQ(misses.load(), 0);
+    for (int i = 0; i < n; i += 2)
+        ASSERT_TRUE(s.Contains(i));
+}
@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Graph.hpp"
+#include "CsrGraph.hpp"
+#include "CompressedGraph.hpp"
+
+class CsrGraphFixture : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        srand(5);
+        for (int e = 0; e < m; e++) {
+            // a hub at vertex 0 and plenty of parallel edges
+            Edge edge {e % 7 ? rand() % n : 0, rand() % (n / 4), rand() % 50};
+            edges.push_back(edge);
+            g.AddEdge(edge.src, edge.dest, edge.weight);
+        }
+    }
+
+    static std::vector<std::pair<int, int>> Sorted(std::vector<std::pair<int, int>> ls)
+    {
+        std::sort(ls.begin(), ls.end());
+        return ls;
+    }
+
+    static std::vector<std::pair<int, int>> Collect(CsrGraph::NeighborRange range)
+    {
+        return std::vector<std::pair<int, int>>(range.begin(), range.end());
+    }
+
+    static constexpr int n = 3000, m = 50000;
+    std::vector<Edge> edges;
+    Graph g {n};
+};
+
+TEST_F(CsrGraphFixture, MatchesAddEdge) {
+    for (int threads : {1, 2, 5}) {
+        CsrGraph csr(n, edges, CsrOptions{true, false, threads});
+        ASSERT_EQ(csr.E(), 2 * edges.size());
+        for (int v = 0; v < n; v++)
+            ASSERT_EQ(Collect(csr.Neighbors(v)), Sorted(g.Neighbors(v))) << "vertex " << v;
+    }
+}
+
+TEST_F(CsrGraphFixture, Directed) {
+    CsrGraph csr(n, edges, CsrOptions{false, false, 3});
+    std::vector<std::vector<std::pair<int, int>>> expected (n);
+    for (const Edge &edge : edges)
+        expected[edge.src].push_back({edge.dest, edge.weight});
+    EXPECT_EQ(csr.E(), edges.size());
+    for (int v = 0; v < n; v++)
+        ASSERT_EQ(Collect(csr.Neighbors(v)), Sorted(expected[v]));
+}
+
+TEST_F(CsrGraphFixture, DedupKeepsLightest) {
+    std::map<std::pair<int, int>, int> lightest;
+    for (const Edge &edge : edges) {
+        for (auto key : {std::make_pair(edge.src, edge.dest), std::make_pair(edge.dest, edge.src)}) {
+            auto it = lightest.find(key);
+            if (it == lightest.end() || edge.weight < it->second)
+                lightest[key] = edge.weight;
+        }
+    }
+    CsrGraph csr(n, edges, CsrOptions{true, true, 4});
+    ASSERT_EQ(csr.E(), lightest.size());
+    auto it = lightest.begin();
+    for (int v = 0; v < n; v++) {
+        EXPECT_EQ(csr.Degree(v), csr.Neighbors(v).size());
+        for (std::pair<int, int> edge : csr.Neighbors(v)) {
+            ASSERT_EQ(it->first, std::make_pair(v, edge.first));
+            ASSERT_EQ(it->second, edge.second);
+            ++it;
+        }
+    }
+}
+
+TEST_F(CsrGraphFixture, Algorithms) {
+    CsrGraph csr(n, edges, CsrOptions{true, true});
+    EXPECT_EQ(csr.BFS(0), g.BFS(0));
+    CompressedGraph cg(csr);
+    EXPECT_EQ(cg.BFS(1), g.BFS(1));
+    EXPECT_EQ(cg.PrimAlgorithm(), csr.PrimAlgorithm());
+}
+
+TEST(CsrGraph, Empty) {
+    CsrGraph empty(4, {});
+    EXPECT_EQ(empty.E(), 0);
+    for (int v = 0; v < 4; v++)
+        EXPECT_TRUE(empty.Neighbors(v).empty());
+}
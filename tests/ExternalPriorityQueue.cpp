@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ExternalPriorityQueue.hpp"
+
+TEST(ExternalPriorityQueue, InMemory) {
+    ExternalPriorityQueue<int> q;
+    for (int x : {3, 8, 1, 5})
+        q.push(x);
+    EXPECT_EQ(q.size(), 4u);
+    EXPECT_EQ(q.front(), 8);
+    EXPECT_EQ(q.pop(), 8);
+    EXPECT_EQ(q.pop(), 5);
+    EXPECT_EQ(q.runs(), 0u);
+}
+
+TEST(ExternalPriorityQueue, Spills) {
+    // 4 KiB: an insertion heap of 512 ints and 8 runs of 64-int blocks per level
+    ExternalPriorityQueue<int> q (4096, 256);
+    std::priority_queue<int> ref;
+    std::srand(41);
+    for (int i = 0; i < 20000; i++) {
+        const int x = std::rand();
+        q.push(x);
+        ref.push(x);
+    }
+    // 39 spills: fewer than 8 runs left on level 0, and 4 on level 1
+    EXPECT_GT(q.runs(), 0u);
+    EXPECT_LE(q.runs(), 2 * 8u);
+    while (!ref.empty()) {
+        ASSERT_EQ(q.front(), ref.top());
+        ASSERT_EQ(q.pop(), ref.top());
+        ref.pop();
+    }
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.runs(), 0u);
+}
+
+TEST(ExternalPriorityQueue, MergesByLevel) {
+    // 256 spills of 512 ints, merged 8 runs at a time: every element is
+    // written to level 0 and rewritten on levels 1 and 2, never more
+    ExternalPriorityQueue<int> q (4096, 256);
+    std::priority_queue<int> ref;
+    const size_t spills = 256, heap = 512, fanIn = 8;
+    std::srand(41);
+    for (size_t i = 0; i < spills * heap + 1; i++) {
+        const int x = std::rand();
+        q.push(x);
+        ref.push(x);
+    }
+    size_t levels = 1;
+    for (size_t runs = fanIn; runs <= spills; runs *= fanIn)
+        levels++;
+    EXPECT_EQ(levels, 3u);
+    EXPECT_LE(q.written(), spills * heap * levels);
+    EXPECT_LE(q.runs(), levels * (fanIn - 1));
+    while (!ref.empty()) {
+        ASSERT_EQ(q.pop(), ref.top());
+        ref.pop();
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(ExternalPriorityQueue, EventSimulation) {
+    // a min queue of timestamped events, every event scheduling later ones
+    struct Event {
+        std::uint64_t time;
+        int id;
+        bool operator>(const Event &e) const
+        {
+            return time > e.time || (time == e.time && id > e.id);
+        }
+    };
+    ExternalPriorityQueue<Event, std::greater<Event>> q (2048, 128);
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> ref;
+    std::srand(41);
+    int next = 0;
+    for (int i = 0; i < 100; i++) {
+        const Event e {static_cast<std::uint64_t>(std::rand() % 1000), next++};
+        q.push(e), ref.push(e);
+    }
+    for (int step = 0; step < 50000 && !ref.empty(); step++) {
+        const Event e = q.pop();
+        ASSERT_EQ(e.id, ref.top().id);
+        ref.pop();
+        for (int k = std::rand() % 3; k > 0; k--) {
+            const Event later {e.time + std::rand() % 1000, next++};
+            q.push(later), ref.push(later);
+        }
+        ASSERT_EQ(q.size(), ref.size());
+    }
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <gtest/gtest.h>
+#include "EytzingerArray.hpp"
+
+template<typename C>
+void CheckBounds(const std::vector<int> &sorted, const EytzingerArray<int, C> &a, int key,
+                 const C &comp)
+{
+    auto lb = std::lower_bound(sorted.begin(), sorted.end(), key, comp);
+    const int *x = a.LowerBound(key);
+    ASSERT_EQ(x == nullptr, lb == sorted.end()) << key;
+    if (x != nullptr) {
+        ASSERT_EQ(*x, *lb) << key;
+    }
+    auto ub = std::upper_bound(sorted.begin(), sorted.end(), key, comp);
+    const int *y = a.UpperBound(key);
+    ASSERT_EQ(y == nullptr, ub == sorted.end()) << key;
+    if (y != nullptr) {
+        ASSERT_EQ(*y, *ub) << key;
+    }
+    ASSERT_EQ(a.Contains(key), std::binary_search(sorted.begin(), sorted.end(), key, comp));
+}
+
+TEST(EytzingerArray, EverySize) {
+    // complete trees and all the shapes in between
+    for (int n = 0; n <= 130; n++) {
+        std::vector<int> sorted(n);
+        for (int i = 0; i < n; i++)
+            sorted[i] = 2 * i;
+        EytzingerArray<int> a(sorted.begin(), sorted.end());
+        ASSERT_EQ(a.Size(), static_cast<std::size_t>(n));
+        for (int key = -1; key <= 2 * n; key++)
+            CheckBounds(sorted, a, key, std::less<int>());
+    }
+}
+
+TEST(EytzingerArray, DuplicatesAndComparator) {
+    std::srand(23);
+    std::vector<int> sorted(10000);
+    for (int &x : sorted)
+        x = std::rand() % 3000;
+    std::sort(sorted.begin(), sorted.end(), std::greater<int>());
+    EytzingerArray<int, std::greater<int>> a(sorted.begin(), sorted.end());
+    for (int key = -5; key < 3005; key++)
+        CheckBounds(sorted, a, key, std::greater<int>());
+
+    EytzingerArray<int> empty;
+    EXPECT_EQ(empty.LowerBound(1), nullptr);
+    EXPECT_FALSE(empty.Contains(0));
+}
+
+TEST(EytzingerArray, ConstructsKeysInPlace) {
+    // neither default-constructible nor assignable
+    struct Key {
+        const int value;
+        explicit Key(int value) : value(value) {}
+        bool operator<(const Key &k) const
+        {
+            return value < k.value;
+        }
+    };
+    int next = 0;
+    EytzingerArray<Key> a(100, [&] { return Key(3 * next++); });
+    ASSERT_EQ(a.Size(), 100u);
+    EXPECT_EQ(a.LowerBound(Key(31))->value, 33);
+    EXPECT_TRUE(a.Contains(Key(297)));
+    EXPECT_EQ(a.UpperBound(Key(297)), nullptr);
+
+    EytzingerArray<Key> moved = std::move(a);
+    EXPECT_EQ(a.Size(), 0u);
+    EXPECT_EQ(a.data(), nullptr);
+    EXPECT_TRUE(moved.Contains(Key(0)));
+
+    // a key that fails to copy leaves no key behind
+    next = 0;
+    auto failing = [&] {
+        if (next == 40)
+            throw 40;
+        return std::vector<int>(next++, 1);
+    };
+    EXPECT_THROW((EytzingerArray<std::vector<int>>(100, failing)), int);
+}
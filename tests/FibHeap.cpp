@@ -1,55 +1,60 @@
 #include <algorithm>
 #include <array>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 #include "FibHeap.hpp"
-#include "List.hpp"
 
 TEST(FibTest, TestInsert) {
-    FibHeap h;
+    FibHeap<int, int> h;
     std::array<int, 3> vals {4, 1, 3};
     for (auto r = vals.rbegin(); r != vals.rend(); r++)
-        h.InsertVal(*r);
+        h.Insert(*r, 0);
     // manually inspect the rootList of the fibonacci heap
-    List<FibNode*> &rootl = h.rootList();
     int ival = 0;
-    for (FibNode *node : rootl)
-        EXPECT_EQ(node->key, vals[ival++]);
+    for (int key : h.rootList())
+        EXPECT_EQ(key, vals[ival++]);
     EXPECT_EQ(h.size(), 3);
 }
 
 class FibHeapFixture : public ::testing::Test {
 protected:
+    using Heap = FibHeap<int, int>;
+
     void SetUp() override {
-        for (int i = 0; i < medSz; i++)
-            medNodes[i] = new FibNode(medLs[i]);
-        for (int i = 0; i < smallSz; i++)
-            smallNodes[i] = new FibNode(smallLs[i]);
-        for (auto r = medNodes.rbegin(); r != medNodes.rend(); r++)
-            medH.Insert(*r);
-        for (auto r = smallNodes.rbegin(); r != smallNodes.rend(); r++)
-            smallH.Insert(*r);
+        for (int i = medSz - 1; i >= 0; i--)
+            medHandles[i] = medH.Insert(medLs[i], i);
+        for (int i = smallSz - 1; i >= 0; i--)
+            smallHandles[i] = smallH.Insert(smallLs[i], i);
     }
 
-    FibHeap medH, smallH;
+    Heap medH, smallH;
     static constexpr int medSz = 10, smallSz = 4;
     // stores the values of the heap
     std::array<int, medSz> medLs {18, 7, 10, 2, 43, 8, 23, 3, 30, 11};
     std::array<int, smallSz> smallLs {31, 1, 9, 5};
-    // stores the corresponding  fibonacci nodes of the heap
-    std::array<FibNode*, medSz> medNodes;
-    std::array<FibNode*, smallSz> smallNodes;
+    // stores the corresponding handles of the heap
+    std::array<Heap::Handle, medSz> medHandles;
+    std::array<Heap::Handle, smallSz> smallHandles;
 };
 
 TEST_F(FibHeapFixture, TestExtractMin) {
-    std::sort(medLs.begin(), medLs.end()); // 2, 3, 7, 8, 10, 11, 18, 23, 30, 43
-    std::sort(smallLs.begin(), smallLs.end()); // 1, 5, 9, 31
-    for (int medVal : medLs) {
-        int medExtMin = medH.ExtractMinVal();
-        EXPECT_EQ(medExtMin, medVal);
+    std::array<int, medSz> medSorted (medLs);
+    std::sort(medSorted.begin(), medSorted.end()); // 2, 3, 7, 8, 10, 11, 18, 23, 30, 43
+    for (int medVal : medSorted) {
+        std::pair<int, int> medExtMin = medH.ExtractMin();
+        EXPECT_EQ(medExtMin.first, medVal);
+        EXPECT_EQ(medLs[medExtMin.second], medVal);  // the value travels along
     }
     EXPECT_TRUE(medH.empty());
+    std::sort(smallLs.begin(), smallLs.end()); // 1, 5, 9, 31
     for (int smallVal : smallLs) {
-        int smallExtMin = smallH.ExtractMinVal();
+        int smallExtMin = smallH.ExtractMin().first;
         EXPECT_EQ(smallExtMin, smallVal);
     }
     EXPECT_TRUE(smallH.empty());
@@ -57,22 +62,106 @@ TEST_F(FibHeapFixture, TestExtractMin) {
 
 TEST_F(FibHeapFixture, TestDecreaseKey) {
     int smallx = *std::min_element(smallLs.begin(), smallLs.end()) - 1;
-    smallH.DecreaseKey(smallNodes[2], smallx);  // decrease a key to the smallest
-    EXPECT_EQ(smallH.minVal(), smallx);
+    smallH.DecreaseKey(smallHandles[2], smallx);  // decrease a key to the smallest
+    EXPECT_EQ(smallH.minKey(), smallx);
+    EXPECT_EQ(smallH.minValue(), 2);
 
-    int medMinOrig = medH.minVal();
+    int medMinOrig = medH.minKey();
     int medx = *std::min_element(medLs.begin(), medLs.end()) + 1;
-    medH.DecreaseKey(medNodes[4], medx);  // decrease a key to the 2nd smallest
-    EXPECT_EQ(medMinOrig, medH.minVal());
+    medH.DecreaseKey(medHandles[4], medx);  // decrease a key to the 2nd smallest
+    EXPECT_EQ(medMinOrig, medH.minKey());
+    EXPECT_EQ(medH.key(medHandles[4]), medx);
+}
+
+TEST_F(FibHeapFixture, TestDelete) {
+    medH.ExtractMin();  // consolidate into trees first
+    medH.Delete(medHandles[0]);  // 18
+    medH.Delete(medHandles[7]);  // 3, the minimum
+    std::vector<int> rest;
+    while (!medH.empty())
+        rest.push_back(medH.ExtractMin().first);
+    EXPECT_EQ(rest, std::vector<int>({7, 8, 10, 11, 23, 30, 43}));
 }
 
 TEST_F(FibHeapFixture, TestUnion) {
     int medMin = *std::min_element(medLs.begin(), medLs.end());
-    EXPECT_EQ(medH.minVal(), medMin);
+    EXPECT_EQ(medH.minKey(), medMin);
 
     medH.Union(std::move(smallH));  // union the two heaps
     int smallMin = *std::min_element(smallLs.begin(), smallLs.end());
     int allMin = std::min(medMin, smallMin);
-    EXPECT_EQ(medH.minVal(), allMin);
+    EXPECT_EQ(medH.minKey(), allMin);
+    EXPECT_TRUE(smallH.empty());
+    // handles into the unioned heap remain valid
+    medH.DecreaseKey(smallHandles[0], allMin - 1);
+    EXPECT_EQ(medH.minValue(), 0);
+    EXPECT_EQ(medH.size(), medSz + smallSz);
+}
+
+TEST(FibTest, TestCompareAndPayload) {
+    // a max heap of owned payloads, destroyed with entries left inside
+    FibHeap<std::string, std::unique_ptr<int>, std::greater<std::string>> h;
+    h.Insert("pear", std::make_unique<int>(1));
+    auto apple = h.Insert("apple", std::make_unique<int>(2));
+    h.Insert("fig", std::make_unique<int>(3));
+    h.DecreaseKey(apple, "zucchini");
+    EXPECT_EQ(*h.value(apple), 2);
+    std::pair<std::string, std::unique_ptr<int>> top = h.ExtractMin();
+    EXPECT_EQ(top.first, "zucchini");
+    EXPECT_EQ(*top.second, 2);
+    EXPECT_EQ(h.minKey(), "pear");
 }
 
+TEST(FibTest, TestRandomOperations) {
+    // Dijkstra-like mix of inserts, decrease-keys, deletes and extract-mins,
+    // checked against an ordered set of (key, id) pairs.
+    using Heap = FibHeap<int, int>;
+    srand(31);
+    Heap h;
+    std::set<std::pair<int, int>> expected;
+    std::vector<Heap::Handle> handles;
+    std::vector<int> live;  // ids still in the heap
+    std::vector<int> where;  // index of every id in live
+    auto forget = [&](int id) {
+        where[live.back()] = where[id];
+        live[where[id]] = live.back();
+        live.pop_back();
+    };
+    for (int i = 0; i < 20000; i++) {
+        int op = rand() % 9;
+        if (op < 3 || live.empty()) {
+            int id = handles.size(), key = rand() % 100000;
+            expected.insert({key, id});
+            where.push_back(live.size());
+            live.push_back(id);
+            if (op == 0) {
+                Heap other;  // also exercise Union
+                handles.push_back(other.Insert(key, id));
+                h.Union(std::move(other));
+            } else {
+                handles.push_back(h.Insert(key, id));
+            }
+        } else if (op < 6) {
+            int id = live[rand() % live.size()];
+            int key = h.key(handles[id]);
+            int decreased = key - rand() % 1000;
+            expected.erase({key, id});
+            expected.insert({decreased, id});
+            h.DecreaseKey(handles[id], decreased);
+        } else if (op == 6) {
+            int id = live[rand() % live.size()];
+            expected.erase({h.key(handles[id]), id});
+            h.Delete(handles[id]);
+            forget(id);
+        } else {
+            std::pair<int, int> entry = h.ExtractMin();
+            ASSERT_EQ(entry.first, expected.begin()->first);
+            ASSERT_EQ(expected.erase(entry), 1u);
+            forget(entry.second);
+        }
+        ASSERT_EQ(h.size(), static_cast<int>(expected.size()));
+        if (!h.empty()) {
+            ASSERT_EQ(h.minKey(), expected.begin()->first);
+        }
+    }
+}
@@ -43,3 +43,51 @@ TEST(PrimAlgorithm, NormalGraphB) {
     EXPECT_EQ(parent, expected_parent);
 }
 
+
+TEST(CommonNeighbors, SmallGraph) {
+    Graph g(6);
+    std::pair<int, int> edges[] = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3},
+        {2, 3}, {3, 4}, {4, 5}, {1, 0}, {2, 2}};  // one parallel edge, one loop
+    for (auto edge : edges)
+        g.AddEdge(edge.first, edge.second);
+    EXPECT_EQ(g.CommonNeighbors(0, 1), std::vector<int>({2, 3}));
+    EXPECT_EQ(g.CommonNeighbors(2, 4), std::vector<int>({3}));
+    EXPECT_EQ(g.CommonNeighbors(3, 5), std::vector<int>({4}));
+    EXPECT_TRUE(g.CommonNeighbors(0, 5).empty());
+}
+
+TEST(CountTriangles, Clique) {
+    const int n = 12;
+    Graph clique(n);
+    for (int u = 0; u < n; u++)
+        for (int v = u + 1; v < n; v++)
+            clique.AddEdge(u, v);
+    EXPECT_EQ(clique.CountTriangles(1), n * (n - 1) * (n - 2) / 6);
+    EXPECT_EQ(clique.CountTriangles(4), n * (n - 1) * (n - 2) / 6);
+}
+
+TEST(CountTriangles, RandomGraph) {
+    const int n = 300, m = 6000;
+    std::vector<std::vector<bool>> adj (n, std::vector<bool>(n, false));
+    Graph g(n);
+    srand(7);
+    for (int e = 0; e < m; e++) {
+        int u = rand() % n, v = rand() % n;
+        g.AddEdge(u, v);
+        adj[u][v] = adj[v][u] = true;
+    }
+    long long expected = 0;
+    for (int u = 0; u < n; u++)
+        for (int v = u + 1; v < n; v++)
+            for (int w = v + 1; w < n; w++)
+                expected += adj[u][v] && adj[v][w] && adj[u][w];
+    EXPECT_EQ(g.CountTriangles(1), expected);
+    EXPECT_EQ(g.CountTriangles(3), expected);
+}
+
+TEST(BFS, Path) {
+    Graph path(6);
+    for (int v = 0; v + 2 < 6; v++)
+        path.AddEdge(v, v + 1);
+    EXPECT_EQ(path.BFS(2), std::vector<int>({2, 1, 0, 1, 2, -1}));
+}
@@ -0,0 +1,82 @@
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <gtest/gtest.h>
+#include "IndexedPriorityQueue.hpp"
+
+TEST(IndexedPriorityQueue, PushPop) {
+    IndexedPriorityQueue<int, std::greater<int>> q (6);
+    int keys[] = {7, 3, 9, 1, 8, 2};
+    for (int id = 0; id < 6; id++)
+        q.push(id, keys[id]);
+    EXPECT_EQ(q.size(), 6u);
+    EXPECT_EQ(q.top(), 3);
+    EXPECT_EQ(q.top_key(), 1);
+    int expected[] = {3, 5, 1, 0, 4, 2};
+    for (int id : expected) {
+        EXPECT_TRUE(q.contains(id));
+        EXPECT_EQ(q.pop(), id);
+        EXPECT_FALSE(q.contains(id));
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(IndexedPriorityQueue, UpdateAndErase) {
+    IndexedPriorityQueue<std::string> q (4);  // max queue
+    q.push(0, "b"), q.push(1, "d"), q.push(2, "a"), q.push(3, "c");
+    q.decrease_key(2, "z");  // ranks highest now
+    EXPECT_EQ(q.top(), 2);
+    q.change_key(2, "0");  // and lowest
+    EXPECT_EQ(q.key(2), "0");
+    q.erase(1);
+    q.erase(1);  // absent, ignored
+    EXPECT_EQ(q.size(), 3u);
+    EXPECT_EQ(q.pop(), 3);
+    EXPECT_EQ(q.pop(), 0);
+    EXPECT_EQ(q.pop(), 2);
+    q.push(1, "x");  // ids can come back
+    EXPECT_EQ(q.top(), 1);
+}
+
+TEST(IndexedPriorityQueue, RandomOperations) {
+    const int n = 300;
+    srand(41);
+    IndexedPriorityQueue<int, std::greater<int>> q (n);
+    std::set<std::pair<int, int>> expected;  // (key, id)
+    std::vector<int> keys (n);
+    for (int i = 0; i < 50000; i++) {
+        int id = rand() % n, key = rand() % 1000;
+        switch (rand() % 4) {
+        case 0:
+            if (!q.contains(id)) {
+                q.push(id, key);
+                expected.insert({keys[id] = key, id});
+            }
+            break;
+        case 1:
+            if (q.contains(id)) {
+                expected.erase({keys[id], id});
+                q.change_key(id, key);
+                expected.insert({keys[id] = key, id});
+            }
+            break;
+        case 2:
+            if (q.contains(id))
+                expected.erase({keys[id], id});
+            q.erase(id);
+            break;
+        default:
+            if (!q.empty()) {
+                int top = q.pop();
+                ASSERT_EQ(keys[top], expected.begin()->first);
+                expected.erase({keys[top], top});
+            }
+        }
+        ASSERT_EQ(q.size(), expected.size());
+        if (!q.empty()) {
+            ASSERT_EQ(q.top_key(), expected.begin()->first);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+#include "IntervalTree.hpp"
+
+template<typename Node>
+int CheckMaxEndpoints(const Node *x)
+{
+    if (x == Node::NIL)
+        return -1;
+    const int max = std::max({x->key.high, CheckMaxEndpoints(x->left), CheckMaxEndpoints(x->right)});
+    EXPECT_EQ(x->aug, max);
+    return max;
+}
+
+TEST(IntervalTree, Queries) {
+    // CLRS Figure 14.4
+    IntervalTree<int> t;
+    for (auto i : std::vector<Interval<int>> {{16, 21}, {8, 9}, {25, 30}, {5, 8}, {15, 23},
+                                              {17, 19}, {26, 26}, {0, 3}, {6, 10}, {19, 20}})
+        t.Insert(i.low, i.high);
+    EXPECT_EQ(t.Overlap(22, 25)->key, (Interval<int>{15, 23}));
+    EXPECT_EQ(t.Overlap(11, 14), (RbNode<Interval<int>, RbMaxEndpoint<int>>::NIL));
+
+    EXPECT_EQ(t.Stabbing(8), (std::vector<Interval<int>> {{5, 8}, {6, 10}, {8, 9}}));
+    EXPECT_EQ(t.Overlapping(20, 25),
+              (std::vector<Interval<int>> {{15, 23}, {16, 21}, {19, 20}, {25, 30}}));
+    EXPECT_TRUE(t.Overlapping(31, 40).empty());
+
+    EXPECT_TRUE(t.Erase(15, 23));
+    EXPECT_FALSE(t.Erase(15, 23));
+    EXPECT_EQ(t.Overlapping(22, 24), (std::vector<Interval<int>> {}));
+    CheckMaxEndpoints(t.Root());
+}
+
+TEST(IntervalTree, RandomOperations) {
+    IntervalTree<int, true> t;
+    std::vector<Interval<int>> ref;
+    std::srand(45);
+    for (int i = 0; i < 20000; i++) {
+        const int low = std::rand() % 10000, high = low + std::rand() % 200;
+        if (std::rand() % 4 == 0 && !ref.empty()) {
+            const size_t j = std::rand() % ref.size();
+            ASSERT_TRUE(t.Erase(ref[j].low, ref[j].high));
+            ref.erase(ref.begin() + j);
+        } else {
+            t.Insert(low, high);
+            ref.push_back({low, high});
+        }
+        if (i % 100 == 0) {
+            std::vector<Interval<int>> expected;
+            for (const Interval<int> &r : ref)
+                if (!(high < r.low) && !(r.high < low))
+                    expected.push_back(r);
+            std::sort(expected.begin(), expected.end(), IntervalLess<int>());
+            ASSERT_EQ(t.Overlapping(low, high), expected);
+            ASSERT_EQ(t.Overlap(low, high) == t.Root()->NIL, expected.empty());
+        }
+    }
+    CheckMaxEndpoints(t.Root());
+}
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "KWayMerge.hpp"
+
+using Sorted = std::vector<int>;
+using Range = std::pair<Sorted::const_iterator, Sorted::const_iterator>;
+
+static std::vector<Range> Ranges(const std::vector<Sorted> &runs)
+{
+    std::vector<Range> ranges;
+    for (const Sorted &r : runs)
+        ranges.emplace_back(r.begin(), r.end());
+    return ranges;
+}
+
+TEST(KWayMerge, Small) {
+    std::vector<Sorted> runs {{1, 4, 7}, {}, {2, 2, 9}, {3}, {0, 8}};
+    KWayMerge<Sorted::const_iterator> merge (Ranges(runs));
+    std::vector<int> out;
+    std::vector<size_t> from;
+    for (; !merge.empty(); )
+        out.push_back(merge.front()), from.push_back(merge.pop());
+    EXPECT_EQ(out, (std::vector<int> {0, 1, 2, 2, 3, 4, 7, 8, 9}));
+    EXPECT_EQ(from, (std::vector<size_t> {4, 0, 2, 2, 3, 0, 0, 4, 2}));
+
+    std::vector<int> none;
+    MergeRuns(std::vector<Range>(), std::back_inserter(none));
+    EXPECT_TRUE(none.empty());
+}
+
+TEST(KWayMerge, Stable) {
+    // equal keys come out in run order
+    using Entry = std::pair<int, int>;  // key, run
+    auto byKey = [](const Entry &a, const Entry &b) { return a.first < b.first; };
+    std::vector<std::vector<Entry>> runs (5);
+    for (int r = 0; r < 5; r++)
+        for (int key = 0; key < 10; key++)
+            runs[r].emplace_back(key, r);
+    std::vector<std::pair<std::vector<Entry>::iterator, std::vector<Entry>::iterator>> ranges;
+    for (std::vector<Entry> &r : runs)
+        ranges.emplace_back(r.begin(), r.end());
+    std::vector<Entry> out;
+    MergeRuns(ranges, std::back_inserter(out), byKey);
+    ASSERT_EQ(out.size(), 50u);
+    for (size_t i = 0; i < out.size(); i++)
+        EXPECT_EQ(out[i], Entry(i / 5, i % 5));
+}
+
+TEST(KWayMerge, RandomRuns) {
+    std::srand(40);
+    for (int k : {1, 2, 3, 7, 16, 33}) {
+        std::vector<Sorted> runs (k);
+        std::vector<int> all;
+        for (Sorted &r : runs) {
+            r.resize(std::rand() % 200);
+            for (int &x : r)
+                x = std::rand() % 1000;
+            std::sort(r.begin(), r.end(), std::greater<int>());
+            all.insert(all.end(), r.begin(), r.end());
+        }
+        std::sort(all.begin(), all.end(), std::greater<int>());
+        std::vector<int> out;
+        MergeRuns(Ranges(runs), std::back_inserter(out), std::greater<int>());
+        EXPECT_EQ(out, all);
+    }
+}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "FibHeap.hpp"
+#include "PairingHeap.hpp"
+#include "RankPairingHeap.hpp"
+
+// The heaps sharing the FibHeap interface, checked against the same traces.
+template<typename H>
+class MergeableHeapTest : public ::testing::Test {};
+
+template<typename Key, typename Value, typename Compare = std::less<Key>>
+struct HeapTypes {
+    using Fib = FibHeap<Key, Value, Compare>;
+    using Pairing = PairingHeap<Key, Value, Compare>;
+    using RankPairing = RankPairingHeap<Key, Value, Compare>;
+};
+
+using Heaps = ::testing::Types<HeapTypes<int, int>::Fib, HeapTypes<int, int>::Pairing,
+                               HeapTypes<int, int>::RankPairing>;
+TYPED_TEST_SUITE(MergeableHeapTest, Heaps);
+
+TYPED_TEST(MergeableHeapTest, ExtractSorted) {
+    TypeParam h;
+    std::vector<int> keys {18, 7, 10, 2, 43, 8, 23, 3, 30, 11};
+    for (int i = 0; i < static_cast<int>(keys.size()); i++)
+        h.Insert(keys[i], i);
+    EXPECT_EQ(h.size(), static_cast<int>(keys.size()));
+    std::vector<int> extracted;
+    while (!h.empty()) {
+        std::pair<int, int> entry = h.ExtractMin();
+        EXPECT_EQ(keys[entry.second], entry.first);
+        extracted.push_back(entry.first);
+    }
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(extracted, keys);
+}
+
+TYPED_TEST(MergeableHeapTest, DecreaseKeyAndDelete) {
+    TypeParam h;
+    std::vector<typename TypeParam::Handle> handles;
+    for (int i = 0; i < 100; i++)
+        handles.push_back(h.Insert(100 + i, i));
+    h.ExtractMin();  // build some structure first
+    h.DecreaseKey(handles[50], 5);
+    EXPECT_EQ(h.minKey(), 5);
+    EXPECT_EQ(h.minValue(), 50);
+    h.DecreaseKey(handles[60], 500);  // not a decrease, ignored
+    EXPECT_EQ(h.key(handles[60]), 160);
+    h.Delete(handles[50]);
+    h.Delete(handles[99]);
+    EXPECT_EQ(h.size(), 97);
+    EXPECT_EQ(h.ExtractMin().first, 101);
+}
+
+TYPED_TEST(MergeableHeapTest, Union) {
+    TypeParam a, b;
+    a.Insert(5, 0);
+    a.Insert(9, 1);
+    auto handle = b.Insert(7, 2);
+    b.Insert(3, 3);
+    a.Union(std::move(b));
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 4);
+    EXPECT_EQ(a.minKey(), 3);
+    a.DecreaseKey(handle, 1);  // handles survive the union
+    EXPECT_EQ(a.ExtractMin(), std::make_pair(1, 2));
+    a.Union(std::move(b));  // empty union
+    EXPECT_EQ(a.size(), 3);
+}
+
+TYPED_TEST(MergeableHeapTest, RandomOperations) {
+    // Insert-heavy, decrease-key-heavy and extract-heavy phases, checked
+    // against an ordered set of (key, id) pairs.
+    using Heap = TypeParam;
+    srand(37);
+    Heap h;
+    std::set<std::pair<int, int>> expected;
+    std::vector<typename Heap::Handle> handles;
+    std::vector<int> live, where;  // ids in the heap, index of ids in live
+    auto forget = [&](int id) {
+        where[live.back()] = where[id];
+        live[where[id]] = live.back();
+        live.pop_back();
+    };
+    const int weights[3][3] = {{6, 2, 2}, {2, 6, 2}, {2, 2, 6}};  // insert, decrease, extract
+    for (int phase = 0; phase < 6; phase++) {
+        const int *w = weights[phase % 3];
+        for (int i = 0; i < 5000; i++) {
+            int op = rand() % (w[0] + w[1] + w[2] + 1);
+            if (op < w[0] || live.empty()) {
+                int id = handles.size(), key = rand() % 100000;
+                expected.insert({key, id});
+                where.push_back(live.size());
+                live.push_back(id);
+                if (op == 0) {
+                    Heap other;  // also exercise Union
+                    handles.push_back(other.Insert(key, id));
+                    h.Union(std::move(other));
+                } else {
+                    handles.push_back(h.Insert(key, id));
+                }
+            } else if (op < w[0] + w[1]) {
+                int id = live[rand() % live.size()];
+                int key = h.key(handles[id]), decreased = key - rand() % 1000;
+                expected.erase({key, id});
+                expected.insert({decreased, id});
+                h.DecreaseKey(handles[id], decreased);
+            } else if (op == w[0] + w[1] + w[2]) {
+                int id = live[rand() % live.size()];
+                expected.erase({h.key(handles[id]), id});
+                h.Delete(handles[id]);
+                forget(id);
+            } else {
+                std::pair<int, int> entry = h.ExtractMin();
+                ASSERT_EQ(entry.first, expected.begin()->first);
+                ASSERT_EQ(expected.erase(entry), 1u);
+                forget(entry.second);
+            }
+            ASSERT_EQ(h.size(), static_cast<int>(expected.size()));
+            if (!h.empty()) {
+                ASSERT_EQ(h.minKey(), expected.begin()->first);
+            }
+        }
+    }
+}
+
+using OwningHeaps = ::testing::Types<
+    HeapTypes<std::string, std::unique_ptr<int>, std::greater<std::string>>::Fib,
+    HeapTypes<std::string, std::unique_ptr<int>, std::greater<std::string>>::Pairing,
+    HeapTypes<std::string, std::unique_ptr<int>, std::greater<std::string>>::RankPairing>;
+
+template<typename H>
+class OwningHeapTest : public ::testing::Test {};
+TYPED_TEST_SUITE(OwningHeapTest, OwningHeaps);
+
+TYPED_TEST(OwningHeapTest, MoveOnlyValues) {
+    // a max heap of owned payloads, destroyed with entries left inside
+    TypeParam h;
+    for (int i = 0; i < 50; i++)
+        h.Insert(std::to_string(1000 + i), std::make_unique<int>(i));
+    auto bottom = h.Insert("0", std::make_unique<int>(-1));
+    h.ExtractMin();
+    h.DecreaseKey(bottom, "zucchini");
+    EXPECT_EQ(*h.value(bottom), -1);
+    std::pair<std::string, std::unique_ptr<int>> top = h.ExtractMin();
+    EXPECT_EQ(top.first, "zucchini");
+    EXPECT_EQ(*top.second, -1);
+    EXPECT_EQ(h.minKey(), "1048");
+}
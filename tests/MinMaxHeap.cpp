@@ -0,0 +1,80 @@
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MinMaxHeap.hpp"
+
+TEST(MinMaxHeap, BothEnds) {
+    MinMaxHeap<int> h;
+    for (int x : {5, 1, 9, 3, 7, 2, 8})
+        h.push(x);
+    EXPECT_EQ(h.size(), 7u);
+    EXPECT_EQ(h.min(), 1);
+    EXPECT_EQ(h.max(), 9);
+    EXPECT_EQ(h.pop_max(), 9);
+    EXPECT_EQ(h.pop_min(), 1);
+    EXPECT_EQ(h.pop_max(), 8);
+    EXPECT_EQ(h.pop_min(), 2);
+    EXPECT_EQ(h.min(), 3);
+    EXPECT_EQ(h.max(), 7);
+    h.pop_min(), h.pop_min();
+    EXPECT_EQ(h.min(), h.max());
+    EXPECT_EQ(h.pop_max(), 7);
+    EXPECT_TRUE(h.empty());
+}
+
+TEST(MinMaxHeap, Construction) {
+    Vector<int> v;
+    for (int i = 0; i < 1000; i++)
+        v.push_back((i * 7919) % 1000);
+    MinMaxHeap<int> h (v);
+    MinMaxHeap<int, std::greater<int>> g (v.begin(), v.end());
+    for (int i = 0; i < 500; i++) {
+        EXPECT_EQ(h.pop_min(), i);
+        EXPECT_EQ(h.pop_max(), 999 - i);
+        EXPECT_EQ(g.pop_min(), 999 - i);  // std::greater flips the ends
+        EXPECT_EQ(g.pop_max(), i);
+    }
+    EXPECT_TRUE(h.empty());
+}
+
+TEST(MinMaxHeap, BestK) {
+    // keep the 10 shortest strings seen, serving them shortest first
+    auto shorter = [](const std::string &a, const std::string &b) { return a.size() < b.size(); };
+    MinMaxHeap<std::string, decltype(shorter)> h (shorter);
+    for (int i = 0; i < 100; i++) {
+        h.emplace(1 + (i * 37) % 100, 'x');
+        if (h.size() > 10)
+            h.pop_max();
+    }
+    for (size_t len = 1; len <= 10; len++)
+        EXPECT_EQ(h.pop_min().size(), len);
+}
+
+TEST(MinMaxHeap, RandomOperations) {
+    MinMaxHeap<int> h;
+    std::multiset<int> ref;
+    std::srand(39);
+    for (int i = 0; i < 200000; i++) {
+        const int op = std::rand() % 5;
+        if (op < 3 || ref.empty()) {
+            const int x = std::rand() % 1000;
+            h.push(x);
+            ref.insert(x);
+        } else if (op == 3) {
+            ASSERT_EQ(h.pop_min(), *ref.begin());
+            ref.erase(ref.begin());
+        } else {
+            ASSERT_EQ(h.pop_max(), *ref.rbegin());
+            ref.erase(std::prev(ref.end()));
+        }
+        ASSERT_EQ(h.size(), ref.size());
+        if (!ref.empty()) {
+            ASSERT_EQ(h.min(), *ref.begin());
+            ASSERT_EQ(h.max(), *ref.rbegin());
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MultiQueue.hpp"
+
+TEST(MultiQueue, SingleThread) {
+    MultiQueue<int, std::greater<int>> q (1, 4);
+    EXPECT_EQ(q.shards(), 4);
+    int x;
+    EXPECT_FALSE(q.try_pop(x));
+    for (int i = 0; i < 1000; i++)
+        q.push((i * 7919) % 1000);
+    EXPECT_EQ(q.size(), 1000u);
+
+    // every element comes out once, roughly in order
+    std::vector<int> popped;
+    while (q.try_pop(x))
+        popped.push_back(x);
+    EXPECT_TRUE(q.empty());
+    ASSERT_EQ(popped.size(), 1000u);
+    EXPECT_LT(popped.front(), 100);
+    std::sort(popped.begin(), popped.end());
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(popped[i], i);
+}
+
+TEST(MultiQueue, Concurrent) {
+    // Every thread pushes its own range and pops as much as it pushes; all
+    // elements must come out exactly once.
+    const int threads = 4, perThread = 20000;
+    MultiQueue<std::uint64_t> q (threads);
+    std::vector<std::vector<std::uint64_t>> popped (threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::uint64_t x;
+            for (int i = 0; i < perThread; i++) {
+                q.push(static_cast<std::uint64_t>(t) * perThread + i);
+                if (i % 2 == 1) {
+                    for (int k = 0; k < 2; k++)
+                        if (q.try_pop(x))
+                            popped[t].push_back(x);
+                }
+            }
+        });
+    }
+    for (std::thread &w : workers)
+        w.join();
+    std::vector<std::uint64_t> all;
+    std::uint64_t x;
+    while (q.try_pop(x))
+        all.push_back(x);
+    for (const std::vector<std::uint64_t> &p : popped)
+        all.insert(all.end(), p.begin(), p.end());
+    ASSERT_EQ(all.size(), static_cast<size_t>(threads) * perThread);
+    std::sort(all.begin(), all.end());
+    for (size_t i = 0; i < all.size(); i++)
+        ASSERT_EQ(all[i], i);
+}
+
+TEST(MultiQueue, MeasureRankError) {
+    // push 1..5, then pop 5 (exact), 3 (two above it), 4, 2, 1
+    std::vector<RankEvent<int>> log;
+    std::uint64_t clock = 0;
+    for (int v = 1; v <= 5; v++)
+        log.push_back({clock++, true, v});
+    for (int v : {5, 3, 4, 2, 1})
+        log.push_back({clock++, false, v});
+    std::reverse(log.begin(), log.end());  // replayed by stamp, not position
+    RankError e = MeasureRankError(log);
+    EXPECT_EQ(e.pops, 5u);
+    EXPECT_EQ(e.max, 1u);
+    EXPECT_DOUBLE_EQ(e.mean, 1.0 / 5);
+
+    // the queue is relaxed only by a small factor of its shard count
+    MultiQueue<int> q (1, 8);
+    log.clear();
+    clock = 0;
+    for (int i = 0; i < 20000; i++) {
+        const int v = (i * 7919) % 20000;
+        q.push(v);
+        log.push_back({clock++, true, v});
+        if (i % 2 == 1) {
+            int x;
+            ASSERT_TRUE(q.try_pop(x));
+            log.push_back({clock++, false, x});
+        }
+    }
+    e = MeasureRankError(log);
+    EXPECT_EQ(e.pops, 10000u);
+    EXPECT_GT(e.mean, 0);
+    EXPECT_LT(e.mean, 4.0 * q.shards());
+}
@@ -0,0 +1,39 @@
+#include <memory>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+#include "NodePool.hpp"
+
+TEST(NodePoolTest, RecyclesSlots) {
+    NodePool<std::pair<int, long>> pool;
+    std::vector<std::pair<int, long>*> nodes;
+    for (int i = 0; i < 1000; i++)
+        nodes.push_back(pool.New(i, 2L * i));
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(nodes[i]->second, 2L * nodes[i]->first);
+    const std::size_t capacity = pool.capacity();
+    EXPECT_GE(capacity, 1000u);
+
+    std::set<std::pair<int, long>*> freed (nodes.begin(), nodes.end());
+    for (auto *node : nodes)
+        pool.Delete(node);
+    for (int i = 0; i < 1000; i++)
+        EXPECT_EQ(freed.count(pool.New(i, 0L)), 1u);  // no fresh slots needed
+    EXPECT_EQ(pool.capacity(), capacity);
+}
+
+TEST(NodePoolTest, Merge) {
+    NodePool<std::unique_ptr<int>> a, b;
+    std::unique_ptr<int> *x = a.New(new int(1));
+    std::unique_ptr<int> *y = b.New(new int(2));
+    std::unique_ptr<int> *z = b.New(new int(3));
+    b.Delete(z);
+    a.Merge(std::move(b));
+    EXPECT_EQ(b.capacity(), 0u);
+    EXPECT_EQ(**y, 2);
+    a.Delete(y);  // allocated by b, freed through a
+    a.Delete(x);
+    std::unique_ptr<int> *w = a.New(new int(4));
+    EXPECT_TRUE(w == x || w == y || w == z);
+    a.Delete(w);
+}
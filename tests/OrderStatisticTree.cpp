@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+#include "OrderStatisticTree.hpp"
+
+template<typename Node>
+std::size_t CheckSizes(const Node *x)
+{
+    if (x == Node::NIL)
+        return 0;
+    const std::size_t size = CheckSizes(x->left) + CheckSizes(x->right) + 1;
+    EXPECT_EQ(x->aug, size);
+    return size;
+}
+
+TEST(OrderStatisticTree, SelectAndRank) {
+    OrderStatisticTree<int> t;
+    for (int x : {50, 20, 80, 10, 30, 70, 90, 60})
+        t.Insert(x);
+    EXPECT_EQ(t.Size(), 8u);
+    EXPECT_EQ(t.Select(1)->key, 10);
+    EXPECT_EQ(t.Select(4)->key, 50);
+    EXPECT_EQ(t.Select(8)->key, 90);
+    EXPECT_EQ(t.Select(9), (RbNode<int, RbSubtreeSize>::NIL));
+    EXPECT_EQ(t.Rank(10), 0u);
+    EXPECT_EQ(t.Rank(55), 4u);
+    EXPECT_EQ(t.Rank(100), 8u);
+    t.Erase(50);
+    EXPECT_EQ(t.Select(4)->key, 60);
+    EXPECT_EQ(t.Rank(60), 3u);
+}
+
+TEST(OrderStatisticTree, RandomOperations) {
+    // against a sorted vector, through both the pooled and the plain tree
+    OrderStatisticTree<int, std::greater<int>, true> t;
+    std::vector<int> ref;  // sorted by std::greater
+    std::srand(44);
+    for (int i = 0; i < 30000; i++) {
+        const int x = std::rand() % 3000;
+        auto it = std::lower_bound(ref.begin(), ref.end(), x, std::greater<int>());
+        if (std::rand() % 3 == 0) {
+            const bool present = it != ref.end() && *it == x;
+            ASSERT_EQ(t.Erase(x), present);
+            if (present)
+                ref.erase(it);
+        } else {
+            t.Insert(x);
+            ref.insert(it, x);
+        }
+        const std::size_t k = std::rand() % (ref.size() + 1);
+        ASSERT_EQ(t.Rank(x), static_cast<std::size_t>(
+            std::lower_bound(ref.begin(), ref.end(), x, std::greater<int>()) - ref.begin()));
+        if (k > 0) {
+            ASSERT_EQ(t.Select(k)->key, ref[k - 1]);
+        }
+    }
+    EXPECT_EQ(CheckSizes(t.Root()), ref.size());
+}
+
+TEST(OrderStatisticTree, BulkOperations) {
+    // joins and splits keep the subtree sizes up to date
+    std::vector<int> evens, thirds;
+    for (int i = 0; i < 20000; i += 2)
+        evens.push_back(i);
+    for (int i = 0; i < 20000; i += 3)
+        thirds.push_back(i);
+    OrderStatisticTree<int> t, u;
+    t.Build(evens.begin(), evens.end());
+    EXPECT_EQ(CheckSizes(t.Root()), evens.size());
+    u.Build(thirds.begin(), thirds.end());
+    t.Union(std::move(u), 2);
+    EXPECT_EQ(CheckSizes(t.Root()), 13333u);
+    EXPECT_EQ(t.Select(4)->key, 4);
+    EXPECT_EQ(t.Rank(9000), 6000u);
+
+    OrderStatisticTree<int> greater;
+    EXPECT_TRUE(t.Split(9000, greater));
+    EXPECT_EQ(CheckSizes(t.Root()), 6000u);
+    EXPECT_EQ(CheckSizes(greater.Root()), 7332u);
+    t.Join(9000, std::move(greater));
+    EXPECT_EQ(t.Size(), 13333u);
+    EXPECT_EQ(t.Select(6001)->key, 9000);
+}
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "PersistentRbTree.hpp"
+
+using Tree = PersistentRbTree<int>;
+
+// The black height of x, or -1 if the subtree breaks an invariant.
+int BlackHeight(const Tree::Node *x)
+{
+    if (x == nullptr)
+        return 0;
+    for (const Tree::Node *c : {x->left.get(), x->right.get()}) {
+        if (c != nullptr && x->color == Color::RED && c->color == Color::RED)
+            return -1;
+    }
+    if ((x->left && !(x->left->key < x->key)) || (x->right && !(x->key < x->right->key)))
+        return -1;
+    const int l = BlackHeight(x->left.get()), r = BlackHeight(x->right.get());
+    if (l < 0 || l != r)
+        return -1;
+    return l + (x->color == Color::BLACK);
+}
+
+bool IsValid(const Tree &t)
+{
+    return (t.Root() == nullptr || t.Root()->color == Color::BLACK) &&
+        BlackHeight(t.Root()) >= 0;
+}
+
+std::vector<int> Keys(const Tree &t)
+{
+    std::vector<int> keys;
+    t.ForEach([&](int key) { keys.push_back(key); });
+    return keys;
+}
+
+TEST(PersistentRbTree, MatchesStdSet) {
+    Tree t;
+    std::set<int> ref;
+    std::srand(3);
+    for (int i = 0; i < 50000; i++) {
+        const int x = std::rand() % 2000;
+        if (std::rand() % 2)
+            ASSERT_EQ(t.Insert(x), ref.insert(x).second);
+        else
+            ASSERT_EQ(t.Erase(x), ref.erase(x) == 1);
+        if (i % 500 == 0) {
+            ASSERT_TRUE(IsValid(t));
+            ASSERT_EQ(Keys(t), std::vector<int>(ref.begin(), ref.end()));
+        }
+        const int *lb = t.LowerBound(x);
+        auto it = ref.lower_bound(x);
+        ASSERT_EQ(lb == nullptr, it == ref.end());
+        if (lb != nullptr) {
+            ASSERT_EQ(*lb, *it);
+        }
+    }
+    EXPECT_EQ(t.Size(), ref.size());
+    EXPECT_EQ(*t.Minimum(), *ref.begin());
+    EXPECT_EQ(*t.Maximum(), *ref.rbegin());
+    while (!ref.empty()) {
+        ASSERT_TRUE(t.Erase(*ref.begin()));
+        ref.erase(ref.begin());
+        ASSERT_TRUE(IsValid(t));
+    }
+    EXPECT_TRUE(t.Empty());
+    EXPECT_EQ(t.Minimum(), nullptr);
+}
+
+TEST(PersistentRbTree, Snapshots) {
+    // every snapshot keeps seeing the set as it was when it was taken
+    Tree t;
+    std::vector<Tree> snapshots;
+    std::vector<std::set<int>> expected;
+    std::set<int> ref;
+    std::srand(9);
+    for (int i = 0; i < 5000; i++) {
+        const int x = std::rand() % 1000;
+        if (std::rand() % 3) {
+            t.Insert(x);
+            ref.insert(x);
+        } else {
+            t.Erase(x);
+            ref.erase(x);
+        }
+        if (i % 100 == 0) {
+            snapshots.push_back(t);
+            expected.push_back(ref);
+            EXPECT_TRUE(snapshots.back().SharesRoot(t));
+        }
+    }
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        ASSERT_TRUE(IsValid(snapshots[i]));
+        ASSERT_EQ(Keys(snapshots[i]), std::vector<int>(expected[i].begin(), expected[i].end()));
+        ASSERT_EQ(snapshots[i].Size(), expected[i].size());
+    }
+    EXPECT_FALSE(t.Insert(*t.Minimum()));
+    Tree copy = t;
+    EXPECT_TRUE(copy.SharesRoot(t));  // a failed insert leaves the tree alone
+}
+
+TEST(PersistentRbTree, PathCopying) {
+    // an update shares all but O(lg n) nodes with the previous version
+    Tree t;
+    for (int i = 0; i < 1 << 14; i++)
+        t.Insert(i);
+    const Tree before = t;
+    t.Insert(1 << 20);
+    t.Erase(5000);
+    int shared = 0, total = 0;
+    std::vector<const Tree::Node*> stack {before.Root()};
+    std::set<const Tree::Node*> old;
+    while (!stack.empty()) {
+        const Tree::Node *x = stack.back();
+        stack.pop_back();
+        if (x == nullptr)
+            continue;
+        old.insert(x);
+        stack.push_back(x->left.get());
+        stack.push_back(x->right.get());
+    }
+    stack.push_back(t.Root());
+    while (!stack.empty()) {
+        const Tree::Node *x = stack.back();
+        stack.pop_back();
+        if (x == nullptr)
+            continue;
+        ++total;
+        shared += old.count(x);
+        stack.push_back(x->left.get());
+        stack.push_back(x->right.get());
+    }
+    EXPECT_EQ(total, 1 << 14);
+    EXPECT_GE(shared, total - 4 * 2 * 15);
+    EXPECT_TRUE(before.Contains(5000));
+    EXPECT_FALSE(t.Contains(5000));
+}
+
+TEST(PersistentRbTree, ReadersOnOtherThreads) {
+    PersistentRbTree<std::string> t;
+    for (int i = 0; i < 1000; i++)
+        t.Insert(std::to_string(i));
+    std::atomic<int> errors {0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&errors, snapshot = t] {
+            for (int round = 0; round < 20; round++)
+                for (int i = 0; i < 1000; i++)
+                    errors += !snapshot.Contains(std::to_string(i));
+        });
+    }
+    for (int i = 0; i < 1000; i++) {  // the writer drops every key meanwhile
+        t.Erase(std::to_string(i));
+        t.Insert("x" + std::to_string(i));
+    }
+    for (std::thread &r : readers)
+        r.join();
+    EXPECT_EQ(errors.load(), 0);
+    EXPECT_EQ(t.Size(), 1000u);
+}
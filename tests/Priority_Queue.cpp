@@ -5,8 +5,12 @@
 //  Created by Ye Min Aung on 5/15/21.
 //
 
+#include <algorithm>
+#include <cassert>
 #include <functional>
 #include <cstddef>
+#include <memory>
+#include <vector>
 #include "Priority_Queue.hpp"
 
 template<typename T>
@@ -58,7 +62,52 @@ int Test_Priority_Queue()
         int dequeued = qcomp.dequeue();   // test the dequeue function
         std::cout << "After dequeuing " << dequeued << ", qcomp = " << qcomp.data() << '\n';
     }
-    
+
+    std::vector<uint64_t> sorted (vrand.begin(), vrand.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    // a 4-ary heap: the root sits behind 3 padding slots in data()
+    Priority_Queue<uint64_t, std::greater<uint64_t>, 4> quad (vrand.begin(), vrand.end());
+    std::cout << "Priority_Queue<T, C, 4> quad = " << quad.data() << '\n';
+    for (uint64_t expected : sorted) {
+        uint64_t dequeued = quad.dequeue();
+        assert(dequeued == expected);
+        std::cout << dequeued << (quad.empty() ? '\n' : ' ');
+    }
+    assert(quad.empty());
+
+    // keep the 3 smallest values of vrand with pushpop on a max heap
+    Priority_Queue<uint64_t> smallest (vrand.begin(), vrand.begin() + 3);
+    for (auto it = vrand.begin() + 3; it != vrand.end(); ++it)
+        smallest.pushpop(*it);
+    std::cout << "3 smallest of vrand = " << smallest.data() << '\n';
+    for (int i = 2; i >= 0; i--)
+        assert(smallest.pop() == sorted[i]);
+    assert(smallest.empty());
+
+    // a move-only payload compiles only if no operation copies it
+    Priority_Queue<std::unique_ptr<int>, std::function<bool(const std::unique_ptr<int>&,
+                                                            const std::unique_ptr<int>&)>>
+        owners ([](const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) { return *a < *b; });
+    for (int n : { 5, 1, 8, 3 })
+        owners.push(std::make_unique<int>(n));
+    owners.emplace(new int(6));
+    assert(*owners.front() == 8);
+    std::unique_ptr<int> top = owners.replace_top(std::make_unique<int>(2));
+    assert(*top == 8 && *owners.front() == 6);
+    top = owners.pushpop(std::make_unique<int>(7));
+    assert(*top == 7);
+    for (int n : { 6, 5, 3, 2, 1 })
+        assert(*owners.pop() == n);
+    assert(owners.empty());
+
+    // Vector moves elements in and out as well
+    Vector<std::unique_ptr<int>> ptrs;
+    for (int n = 0; n < 40; n++)
+        ptrs.push_back(std::make_unique<int>(n));
+    for (int n = 39; n >= 0; n--)
+        assert(*ptrs.pop_back() == n);
+
     return 1;
 }
 
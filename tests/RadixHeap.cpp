@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "RadixHeap.hpp"
+
+TEST(RadixHeap, PushPop) {
+    RadixHeap<std::uint32_t, std::string> h;
+    h.push(5, "five"), h.push(3, "three"), h.push(9, "nine"), h.push(3, "three'");
+    EXPECT_EQ(h.size(), 4u);
+    EXPECT_EQ(h.top_key(), 3u);
+    EXPECT_EQ(h.pop().first, 3u);
+    EXPECT_EQ(h.pop().first, 3u);
+    h.push(4, "four");  // still above the last popped key
+    EXPECT_EQ(h.pop(), std::make_pair(4u, std::string("four")));
+    EXPECT_EQ(h.top_value(), "five");
+    EXPECT_EQ(h.pop().first, 5u);
+    EXPECT_EQ(h.pop().first, 9u);
+    EXPECT_TRUE(h.empty());
+}
+
+TEST(RadixHeap, WideKeys) {
+    RadixHeap<std::uint64_t, int> h;
+    const std::uint64_t big = 1ull << 63;
+    h.push(big + 7, 2), h.push(big, 1), h.push(~0ull, 3), h.push(12, 0);
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(h.pop().second, i);
+    h.clear();
+    h.push(0, 0);  // clear() starts over from key 0
+    EXPECT_EQ(h.top_key(), 0u);
+}
+
+TEST(RadixHeap, MonotoneWorkload) {
+    // Dijkstra-like: every push lies within a bounded distance above the
+    // last popped key; checked against std::priority_queue.
+    using Entry = std::pair<std::uint32_t, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> expected;
+    RadixHeap<std::uint32_t, int> h;
+    srand(43);
+    std::uint32_t last = 0;
+    for (int i = 0; i < 100000; i++) {
+        if (rand() % 5 < 3 || h.empty()) {
+            std::uint32_t key = last + rand() % (i % 2 ? 100 : 1000000);
+            h.push(key, i);
+            expected.push({key, i});
+        } else {
+            std::pair<std::uint32_t, int> top = h.pop();
+            ASSERT_EQ(top.first, expected.top().first);
+            last = top.first;
+            expected.pop();
+        }
+        ASSERT_EQ(h.size(), expected.size());
+        if (!h.empty()) {
+            ASSERT_EQ(h.top_key(), expected.top().first);
+        }
+    }
+}
@@ -1,6 +1,11 @@
 #include <array>
 #include <utility>
 #include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
 #include <gtest/gtest.h>
 #include "RbTree.hpp"
 
@@ -16,14 +21,17 @@ void Traverse(const RbNode<int> *x, int height)
         Traverse(x->right, height + 1);
 }
 
-bool HasBoundedHeight(const RbTree<int> &r)
+template<typename Tree>
+bool HasBoundedHeight(const Tree &r)
 {
     gCount = gMaxHeight = 0;
-    Traverse(r.Root(), 0);
+    if (r.Root() != RbNode<int>::NIL)
+        Traverse(r.Root(), 0);
     auto lg = [](int x) {
         return 31 - __builtin_clz(x);
     };
-    return gCount < 2 || gMaxHeight <= 2 * lg(gCount - 1);
+    // n >= 2^bh - 1 nodes, and no path is longer than 2 bh nodes
+    return gCount == 0 || gMaxHeight < 2 * lg(gCount + 1);
 }
 
 bool CheckRbProperty(const RbNode<int> *x, int blackCount)
@@ -44,7 +52,8 @@ bool CheckRbProperty(const RbNode<int> *x, int blackCount)
     return CheckRbProperty(x->left, blackCount) && CheckRbProperty(x->right, blackCount);
 }
 
-bool HasRbProperty(const RbTree<int> &r)
+template<typename Tree>
+bool HasRbProperty(const Tree &r)
 {
     gBlackCount = -1;
     return r.Root()->color == Color::BLACK && CheckRbProperty(r.Root(), 0) &&
@@ -121,3 +130,170 @@ TEST_F(RbTreeFixture, Delete) {
     }
 }
 
+TEST(PooledRbTree, InsertAndErase) {
+    RbTree<int, std::less<int>, true> tree;
+    std::multiset<int> ref;
+    std::srand(42);
+    for (int i = 0; i < 100000; i++) {
+        const int x = std::rand() % 5000;
+        if (std::rand() % 3 == 0) {
+            auto found = ref.find(x);
+            EXPECT_EQ(tree.Erase(x), found != ref.end());
+            if (found != ref.end())
+                ref.erase(found);
+        } else {
+            EXPECT_EQ(tree.Insert(x)->key, x);
+            ref.insert(x);
+        }
+    }
+    ASSERT_TRUE(HasRbProperty(tree));
+    int count = 0;
+    auto it = ref.begin();
+    for (RbNode<int> *x = tree.Minimum(); x != RbNode<int>::NIL; x = tree.Successor(x), ++it) {
+        ASSERT_EQ(x->key, *it);
+        ++count;
+    }
+    EXPECT_EQ(count, static_cast<int>(ref.size()));
+
+    tree.Clear();
+    EXPECT_EQ(tree.Root(), RbNode<int>::NIL);
+    tree.Insert(7);
+    EXPECT_EQ(tree.Minimum()->key, 7);
+}
+
+TEST(PooledRbTree, OwningKeys) {
+    // keys with destructors are destroyed on Erase, Clear and destruction
+    RbTree<std::string, std::less<std::string>, true> tree;
+    for (int i = 0; i < 1000; i++)
+        tree.Insert(std::string(100, 'a' + i % 26) + std::to_string(i));
+    for (int i = 0; i < 1000; i += 2)
+        EXPECT_TRUE(tree.Erase(std::string(100, 'a' + i % 26) + std::to_string(i)));
+    EXPECT_FALSE(tree.Erase("none"));
+    RbTree<std::string> heapNodes;  // the value interface works unpooled too
+    heapNodes.Insert("pear");
+    EXPECT_TRUE(heapNodes.Erase("pear"));
+    EXPECT_EQ(heapNodes.Root(), RbNode<std::string>::NIL);
+}
+
+template<typename Tree>
+std::vector<int> Keys(Tree &tree)
+{
+    std::vector<int> keys;
+    if (tree.Root() == Tree::Node::NIL)
+        return keys;
+    for (auto *x = tree.Minimum(); x != Tree::Node::NIL; x = tree.Successor(x))
+        keys.push_back(x->key);
+    return keys;
+}
+
+std::vector<int> RandomSet(int n, int range)
+{
+    std::set<int> keys;
+    while (static_cast<int>(keys.size()) < n)
+        keys.insert(std::rand() % range);
+    return std::vector<int>(keys.begin(), keys.end());
+}
+
+TEST(BulkRbTree, Build) {
+    for (int n = 0; n < 300; n++) {
+        std::vector<int> keys(n);
+        for (int i = 0; i < n; i++)
+            keys[i] = 3 * i;
+        RbTree<int, std::less<int>, true> tree;
+        tree.Insert(-1);
+        tree.Build(keys.begin(), keys.end());
+        ASSERT_TRUE(HasRbProperty(tree)) << n;
+        ASSERT_EQ(Keys(tree), keys);
+    }
+}
+
+TEST(BulkRbTree, JoinAndSplit) {
+    std::srand(7);
+    for (int round = 0; round < 200; round++) {
+        std::vector<int> low = RandomSet(std::rand() % 500, 10000);
+        std::vector<int> high = RandomSet(std::rand() % 500, 10000);
+        for (int &x : high)
+            x += 20000;
+        RbTree<int> tree, greater;
+        tree.Build(low.begin(), low.end());
+        greater.Build(high.begin(), high.end());
+        tree.Join(15000, std::move(greater));
+        ASSERT_TRUE(HasRbProperty(tree));
+        EXPECT_EQ(greater.Root(), RbNode<int>::NIL);
+        std::vector<int> all = low;
+        all.push_back(15000);
+        all.insert(all.end(), high.begin(), high.end());
+        ASSERT_EQ(Keys(tree), all);
+
+        const int key = all[std::rand() % all.size()] + std::rand() % 2;
+        const bool present = std::binary_search(all.begin(), all.end(), key);
+        EXPECT_EQ(tree.Split(key, greater), present);
+        ASSERT_TRUE(HasRbProperty(tree));
+        ASSERT_TRUE(HasRbProperty(greater));
+        auto mid = std::lower_bound(all.begin(), all.end(), key);
+        EXPECT_EQ(Keys(tree), std::vector<int>(all.begin(), mid));
+        EXPECT_EQ(Keys(greater), std::vector<int>(mid + present, all.end()));
+    }
+}
+
+template<bool Pooled>
+void CheckSetOperations(int threads)
+{
+    std::srand(11);
+    for (auto sizes : {std::make_pair(50000, 20000), std::make_pair(300, 40000),
+                       std::make_pair(0, 1000), std::make_pair(1000, 0)}) {
+        const std::vector<int> a = RandomSet(sizes.first, 100000);
+        const std::vector<int> b = RandomSet(sizes.second, 100000);
+        for (int op = 0; op < 3; op++) {
+            RbTree<int, std::less<int>, Pooled> x, y;
+            x.Build(a.begin(), a.end());
+            y.Build(b.begin(), b.end());
+            std::vector<int> expected;
+            if (op == 0) {
+                x.Union(std::move(y), threads);
+                std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+            } else if (op == 1) {
+                x.Intersection(std::move(y), threads);
+                std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                      std::back_inserter(expected));
+            } else {
+                x.Difference(std::move(y), threads);
+                std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                                    std::back_inserter(expected));
+            }
+            ASSERT_TRUE(HasRbProperty(x)) << op;
+            EXPECT_EQ(y.Root(), RbNode<int>::NIL);
+            ASSERT_EQ(Keys(x), expected) << op;
+            x.Insert(-5);  // the tree stays usable
+            EXPECT_EQ(x.Minimum()->key, -5);
+        }
+    }
+}
+
+TEST(BulkRbTree, SetOperations) {
+    CheckSetOperations<false>(1);
+    CheckSetOperations<false>(4);
+    CheckSetOperations<true>(4);
+}
+
+TEST(RbTree, Freeze) {
+    RbTree<int, std::less<int>, true> tree;
+    std::vector<int> keys;
+    std::srand(29);
+    for (int i = 0; i < 5000; i++) {
+        keys.push_back(std::rand() % 2000);
+        tree.Insert(keys.back());
+    }
+    std::sort(keys.begin(), keys.end());
+    const EytzingerArray<int> frozen = tree.Freeze();
+    ASSERT_EQ(frozen.Size(), keys.size());
+    tree.Clear();  // the copy stands alone
+    for (int key = -1; key <= 2000; key++) {
+        auto lb = std::lower_bound(keys.begin(), keys.end(), key);
+        const int *x = frozen.LowerBound(key);
+        ASSERT_EQ(x == nullptr ? keys.end() : lb, lb);
+        if (x != nullptr) {
+            ASSERT_EQ(*x, *lb);
+        }
+    }
+}
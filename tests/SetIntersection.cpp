@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+#include <gtest/gtest.h>
+#include "SetIntersection.hpp"
+
+std::vector<int> RandomSet(std::size_t size, int range)
+{
+    std::set<int> s;
+    while (s.size() < size)
+        s.insert(rand() % range);
+    return std::vector<int>(s.begin(), s.end());
+}
+
+class SetIntersectionTest : public ::testing::TestWithParam<std::pair<int, int>> {
+protected:
+    using Kernel = std::size_t (*)(const int*, std::size_t, const int*,
+                                   std::size_t, int*);
+
+    void Check(Kernel kernel)
+    {
+        const int na = GetParam().first, nb = GetParam().second;
+        const int range = 2 * std::max(na, nb);
+        srand(na * 31 + nb);
+        for (int round = 0; round < 20; round++) {
+            std::vector<int> a (RandomSet(na, range));
+            std::vector<int> b (RandomSet(nb, range));
+            std::vector<int> expected;
+            std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                                  std::back_inserter(expected));
+            std::vector<int> out (std::min(a.size(), b.size()));
+            std::size_t k = kernel(a.data(), a.size(), b.data(), b.size(), out.data());
+            out.resize(k);
+            EXPECT_EQ(out, expected);
+            EXPECT_EQ(kernel(a.data(), a.size(), b.data(), b.size(), nullptr),
+                      expected.size());
+        }
+    }
+};
+
+TEST_P(SetIntersectionTest, Merge) {
+    Check(IntersectMerge);
+}
+
+TEST_P(SetIntersectionTest, Galloping) {
+    Check(IntersectGalloping);
+}
+
+TEST_P(SetIntersectionTest, SIMD) {
+    Check(IntersectSIMD);
+}
+
+TEST_P(SetIntersectionTest, Dispatch) {
+    Check(Intersect);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, SetIntersectionTest, ::testing::Values(
+    std::make_pair(0, 10), std::make_pair(3, 5), std::make_pair(8, 8),
+    std::make_pair(17, 100), std::make_pair(100, 100), std::make_pair(1000, 997),
+    std::make_pair(10, 5000), std::make_pair(4000, 20)));
+
+TEST(SetIntersection, Identical) {
+    std::vector<int> a (RandomSet(500, 2000)), out (500);
+    EXPECT_EQ(IntersectSIMD(a.data(), a.size(), a.data(), a.size(), out.data()), 500);
+    EXPECT_EQ(out, a);
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+#include "ShortestPaths.hpp"
+
+// Textbook triple loop, used as the reference.
+std::vector<int> NaiveFloydWarshall(std::vector<int> d, int n)
+{
+    for (int k = 0; k < n; k++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                if (d[i * n + k] != INF_DIST && d[k * n + j] != INF_DIST)
+                    d[i * n + j] = std::min(d[i * n + j], d[i * n + k] + d[k * n + j]);
+    return d;
+}
+
+// Random directed edges with weights w + p[u] - p[v] for w >= 0: some are
+// negative, but every cycle has non-negative length.
+std::vector<Edge> RandomEdges(int n, int m, bool negative)
+{
+    std::vector<int> p (n);
+    for (int &x : p)
+        x = negative ? rand() % 100 : 0;
+    std::vector<Edge> edges;
+    for (int e = 0; e < m; e++) {
+        int u = rand() % n, v = rand() % n;
+        edges.push_back({u, v, rand() % 100 + p[u] - p[v]});
+    }
+    return edges;
+}
+
+std::vector<int> Matrix(int n, const std::vector<Edge> &edges)
+{
+    std::vector<int> d (n * n, INF_DIST);
+    for (int v = 0; v < n; v++)
+        d[v * n + v] = 0;
+    for (const Edge &e : edges)
+        d[e.src * n + e.dest] = std::min(d[e.src * n + e.dest], e.weight);
+    return d;
+}
+
+class ShortestPathsTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(ShortestPathsTest, FloydWarshall) {
+    const int n = GetParam();
+    srand(n);
+    for (bool negative : {false, true}) {
+        std::vector<int> d (Matrix(n, RandomEdges(n, 3 * n, negative)));
+        std::vector<int> expected (NaiveFloydWarshall(d, n));
+        ASSERT_TRUE(FloydWarshall(d, n, 3));
+        EXPECT_EQ(d, expected);
+    }
+}
+
+TEST_P(ShortestPathsTest, Johnson) {
+    const int n = GetParam();
+    srand(n + 1);
+    for (bool negative : {false, true}) {
+        std::vector<Edge> edges (RandomEdges(n, 3 * n, negative));
+        std::vector<int> d;
+        ASSERT_TRUE(Johnson(CsrGraph(n, edges, CsrOptions{false}), d, 2));
+        EXPECT_EQ(d, NaiveFloydWarshall(Matrix(n, edges), n));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, ShortestPathsTest, ::testing::Values(1, 5, 64, 100, 150));
+
+TEST(ShortestPaths, NegativeCycle) {
+    std::vector<Edge> edges {{0, 1, 2}, {1, 2, -3}, {2, 0, 0}, {2, 3, 1}};
+    std::vector<int> d (Matrix(4, edges));
+    EXPECT_FALSE(FloydWarshall(d, 4));
+    EXPECT_FALSE(Johnson(CsrGraph(4, edges, CsrOptions{false}), d));
+}
+
+TEST(ShortestPaths, Dijkstra) {
+    Graph g(5);
+    g.AddEdge(0, 1, 4), g.AddEdge(0, 2, 1), g.AddEdge(2, 1, 2), g.AddEdge(1, 3, 5);
+    EXPECT_EQ(Dijkstra(g, 0), std::vector<int>({0, 3, 1, 8, INF_DIST}));
+}
+
+TEST(ShortestPaths, GraphAllPairs) {
+    const int n = 120;
+    srand(3);
+    for (int m : {150, 3000}) {  // sparse (Johnson) and dense (Floyd-Warshall)
+        Graph g(n);
+        std::vector<Edge> edges;
+        for (int e = 0; e < m; e++) {
+            Edge edge {rand() % n, rand() % n, rand() % 1000};
+            g.AddEdge(edge.src, edge.dest, edge.weight);
+            edges.push_back(edge);
+            edges.push_back({edge.dest, edge.src, edge.weight});
+        }
+        EXPECT_EQ(g.AllPairsShortestPaths(2), NaiveFloydWarshall(Matrix(n, edges), n));
+    }
+    Graph negative(2);
+    negative.AddEdge(0, 1, -1);  // undirected, so 0 -> 1 -> 0 is a negative cycle
+    EXPECT_TRUE(negative.AllPairsShortestPaths().empty());
+}
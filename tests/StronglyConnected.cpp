@@ -0,0 +1,109 @@
+#include <map>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompressedGraph.hpp"
+#include "CsrGraph.hpp"
+#include "Graph.hpp"
+#include "StronglyConnected.hpp"
+
+// Two labelings describe the same partition iff they map onto each other.
+bool SamePartition(const std::vector<int> &a, const std::vector<int> &b)
+{
+    if (a.size() != b.size())
+        return false;
+    std::map<int, int> ab, ba;
+    for (std::size_t v = 0; v < a.size(); v++) {
+        if (ab.emplace(a[v], b[v]).first->second != b[v])
+            return false;
+        if (ba.emplace(b[v], a[v]).first->second != a[v])
+            return false;
+    }
+    return true;
+}
+
+// Reference: u and v share a component iff each reaches the other.
+std::vector<int> ClosureSCC(const Graph &g)
+{
+    const int n = g.V();
+    std::vector<std::vector<bool>> reach (n, std::vector<bool>(n, false));
+    for (int u = 0; u < n; u++) {
+        reach[u][u] = true;
+        for (std::pair<int, int> edge : g.Neighbors(u))
+            reach[u][edge.first] = true;
+    }
+    for (int k = 0; k < n; k++)
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                reach[i][j] = reach[i][j] || (reach[i][k] && reach[k][j]);
+    std::vector<int> comp (n, -1);
+    for (int u = 0; u < n; u++)
+        for (int v = 0; v < n && comp[u] == -1; v++)
+            if (reach[u][v] && reach[v][u])
+                comp[u] = comp[v] == -1 ? u : comp[v];
+    return comp;
+}
+
+TEST(StronglyConnected, SmallGraph) {
+    Graph g(8, true);
+    std::pair<int, int> edges[] = {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 5},
+        {5, 3}, {6, 5}, {6, 7}, {7, 6}};
+    for (auto edge : edges)
+        g.AddEdge(edge.first, edge.second);
+    std::vector<int> comp (g.StronglyConnectedComponents());
+    EXPECT_TRUE(SamePartition(comp, {0, 0, 0, 1, 1, 1, 2, 2}));
+    // reverse topological numbering: {3, 4, 5} before {0, 1, 2} and {6, 7}
+    EXPECT_LT(comp[3], comp[0]);
+    EXPECT_LT(comp[3], comp[6]);
+    EXPECT_TRUE(SamePartition(g.ParallelStronglyConnectedComponents(2), comp));
+}
+
+TEST(StronglyConnected, RandomGraphs) {
+    srand(17);
+    for (int round = 0; round < 30; round++) {
+        const int n = 1 + rand() % 60, m = rand() % (3 * n);
+        Graph g(n, true);
+        for (int e = 0; e < m; e++)
+            g.AddEdge(rand() % n, rand() % n);
+        std::vector<int> expected (ClosureSCC(g));
+        EXPECT_TRUE(SamePartition(g.StronglyConnectedComponents(), expected));
+        EXPECT_TRUE(SamePartition(g.ParallelStronglyConnectedComponents(1), expected));
+        EXPECT_TRUE(SamePartition(g.ParallelStronglyConnectedComponents(3), expected));
+    }
+}
+
+TEST(StronglyConnected, Undirected) {
+    Graph g(5);
+    g.AddEdge(0, 3), g.AddEdge(3, 4);
+    EXPECT_TRUE(SamePartition(g.StronglyConnectedComponents(), {0, 1, 2, 0, 0}));
+}
+
+TEST(StronglyConnected, DeepPath) {
+    // a single path of a million vertices closed into a cycle
+    const int n = 1000000;
+    std::vector<Edge> edges;
+    for (int v = 0; v < n; v++)
+        edges.push_back({v, (v + 1) % n, 0});
+    CsrGraph cycle(n, edges, CsrOptions{false});
+    std::vector<int> comp (TarjanSCC(cycle));
+    EXPECT_EQ(*std::max_element(comp.begin(), comp.end()), 0);
+    edges.pop_back();  // now a path: every vertex on its own
+    CsrGraph path(n, edges, CsrOptions{false});
+    comp = TarjanSCC(path);
+    EXPECT_EQ(*std::max_element(comp.begin(), comp.end()), n - 1);
+    EXPECT_EQ(comp[0], n - 1);
+}
+
+TEST(StronglyConnected, LargeGraph) {
+    // large enough for the parallel searches to kick in
+    const int n = 60000;
+    srand(23);
+    std::vector<Edge> edges;
+    for (int e = 0; e < 2 * n; e++)
+        edges.push_back({rand() % n, rand() % n, 0});
+    CsrGraph g(n, edges, CsrOptions{false});
+    std::vector<int> expected (TarjanSCC(g));
+    EXPECT_TRUE(SamePartition(ForwardBackwardSCC(g, 4), expected));
+    EXPECT_TRUE(SamePartition(ForwardBackwardSCC(CompressedGraph(g), 2), expected));
+    EXPECT_TRUE(SamePartition(TarjanSCC(CompressedGraph(g)), expected));
+}
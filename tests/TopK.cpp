@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "TopK.hpp"
+
+TEST(TopK, Stream) {
+    TopK<int> top (3);
+    EXPECT_FALSE(top.full());
+    for (int x : {4, 9, 1, 7})
+        top.push(x);
+    EXPECT_TRUE(top.full());
+    EXPECT_EQ(top.threshold(), 4);
+    EXPECT_FALSE(top.push(2));  // below the threshold
+    EXPECT_TRUE(top.push(8));
+    EXPECT_EQ(top.threshold(), 7);
+    Vector<int> best = top.take();
+    ASSERT_EQ(best.size(), 3u);
+    EXPECT_EQ(best[0], 9);
+    EXPECT_EQ(best[1], 8);
+    EXPECT_EQ(best[2], 7);
+    EXPECT_EQ(top.size(), 0u);
+}
+
+TEST(TopK, Batch) {
+    std::srand(40);
+    std::vector<int> stream (100000);
+    for (int &x : stream)
+        x = std::rand();
+    for (size_t k : {0, 1, 10, 1000}) {
+        TopK<int, std::greater<int>> top (k);  // the k smallest
+        top.push(stream.begin(), stream.begin() + 500);
+        for (auto it = stream.begin() + 500; it != stream.end(); ++it)
+            top.push(*it);
+        std::vector<int> sorted (stream);
+        std::sort(sorted.begin(), sorted.end());
+        Vector<int> best = top.take();
+        ASSERT_EQ(best.size(), k);
+        for (size_t i = 0; i < k; i++)
+            EXPECT_EQ(best[i], sorted[i]);
+    }
+}
+
+TEST(TopK, Strings) {
+    TopK<std::string> top (2);
+    std::vector<std::string> words {"pear", "apple", "plum", "fig", "quince"};
+    top.push(words.begin(), words.end());
+    Vector<std::string> best = top.take();
+    EXPECT_EQ(best[0], "quince");
+    EXPECT_EQ(best[1], "plum");
+}